@@ -69,7 +69,7 @@ byte bmp388_read_reg(byte const reg_addr)
   /* REG_ADDR | DUMMY_BYTE | REG_VAL is on SDO */
   byte read_write_buf[] = {static_cast<byte>(0x80 | reg_addr), 0, 0};
 
-  IoRequest req(read_write_buf, sizeof(read_write_buf), nullptr, 0);
+  IoRequest req(read_write_buf, read_write_buf, sizeof(read_write_buf));
   IoResponse rsp = transferAndWait(bmp388, req);
 
   return read_write_buf[2];
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_BENCHMARK_H_
+#define ARDUINO_THREADS_HOST_BENCHMARK_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <cstdio>
+#include <chrono>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+class Stopwatch
+{
+public:
+
+  Stopwatch() : _start{std::chrono::steady_clock::now()} { }
+
+  double elapsed_s() const
+  {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+  }
+
+
+private:
+
+  std::chrono::steady_clock::time_point _start;
+
+};
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+inline void report(const char * name, size_t const ops, double const seconds)
+{
+  printf("%-48s %10zu ops %10.3f ms %10.1f ns/op\n", name, ops, seconds * 1e3, seconds * 1e9 / ops);
+}
+
+#endif /* ARDUINO_THREADS_HOST_BENCHMARK_H_ */
@@ -0,0 +1,82 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino_Threads.h>
+
+#include "benchmark.h"
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+static size_t constexpr NUM_LINES = 20000;
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+static char constexpr LINE[] = "The quick brown fox jumps over the lazy dog";
+
+static void benchmark_println(size_t const num_threads, size_t const tx_buffer_size, bool const blocking)
+{
+  rtos::Thread threads[8];
+
+  SerialUSB.resetStatistics();
+  Stopwatch sw;
+  for (size_t t = 0; t < num_threads; t++)
+    threads[t].start([tx_buffer_size, blocking]()
+    {
+      Serial.begin(115200, SERIAL_8N1, tx_buffer_size);
+      if (blocking)
+        Serial.setWriteTimeout(rtos::Kernel::wait_for_u32_forever);
+      for (size_t i = 0; i < NUM_LINES; i++)
+        Serial.println(LINE);
+      Serial.end();
+    });
+  for (size_t t = 0; t < num_threads; t++)
+    threads[t].join();
+
+  char name[64];
+  snprintf(name, sizeof(name), "Serial.println (%zu threads, %zu B, %s)", num_threads, tx_buffer_size, blocking ? "blocking" : "truncating");
+  report(name, NUM_LINES * num_threads, sw.elapsed_s());
+  /* Wait for the dispatcher to drain the transmit buffers. */
+  rtos::ThisThread::sleep_for(100);
+  size_t const bytes_expected = NUM_LINES * num_threads * (strlen(LINE) + 2);
+  printf("%-48s %10zu of %zu bytes written\n", "", SerialUSB.bytesWritten(), bytes_expected);
+}
+
+/**************************************************************************************
+ * MAIN
+ **************************************************************************************/
+
+int main()
+{
+  /* Keeps the dispatcher running while the benchmark threads end(). */
+  Serial.begin(115200);
+
+  benchmark_println(1, 128, false);
+  benchmark_println(1, 128, true);
+  benchmark_println(1, 1024, true);
+  benchmark_println(4, 128, true);
+  benchmark_println(8, 128, true);
+  return 0;
+}
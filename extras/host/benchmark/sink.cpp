@@ -0,0 +1,266 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino_Threads.h>
+
+#include <atomic>
+
+#include "benchmark.h"
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+static size_t constexpr NUM_SAMPLES = 200000;
+static size_t constexpr NUM_FRAMES  =  50000;
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+struct Frame
+{
+  uint8_t data[512];
+};
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+template<typename SinkType>
+static void benchmark_source_sink(const char * name, SinkType & sink)
+{
+  Source<int> source;
+  source.connectTo(sink);
+
+  rtos::Thread consumer;
+  volatile long sum = 0;
+  consumer.start([&]() { for (size_t i = 0; i < NUM_SAMPLES; i++) sum += sink.pop(); });
+
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_SAMPLES; i++)
+    source.push(static_cast<int>(i));
+  consumer.join();
+
+  report(name, NUM_SAMPLES, sw.elapsed_s());
+}
+
+template<typename SinkType>
+static void benchmark_source_sink_batch(const char * name, SinkType & sink)
+{
+  static size_t constexpr BATCH_SIZE = 16;
+
+  Source<int> source;
+  source.connectTo(sink);
+
+  rtos::Thread consumer;
+  volatile long sum = 0;
+  consumer.start([&]()
+  {
+    int batch[BATCH_SIZE];
+    for (size_t i = 0; i < NUM_SAMPLES; )
+    {
+      size_t const num = sink.pop(batch, BATCH_SIZE);
+      for (size_t j = 0; j < num; j++) sum += batch[j];
+      i += num;
+    }
+  });
+
+  Stopwatch sw;
+  int batch[BATCH_SIZE];
+  for (size_t i = 0; i < NUM_SAMPLES; i += BATCH_SIZE)
+  {
+    for (size_t j = 0; j < BATCH_SIZE; j++) batch[j] = static_cast<int>(i + j);
+    source.push(batch, BATCH_SIZE);
+  }
+  consumer.join();
+
+  report(name, NUM_SAMPLES, sw.elapsed_s());
+}
+
+static void benchmark_frame_copy()
+{
+  Source<Frame> source;
+  SinkBlocking<Frame, 4> sink_1, sink_2;
+  source.connectTo(sink_1);
+  source.connectTo(sink_2);
+
+  rtos::Thread consumer_1, consumer_2;
+  volatile long sum_1 = 0, sum_2 = 0; /* One per consumer, they run concurrently. */
+  consumer_1.start([&]() { for (size_t i = 0; i < NUM_FRAMES; i++) sum_1 += sink_1.pop().data[0]; });
+  consumer_2.start([&]() { for (size_t i = 0; i < NUM_FRAMES; i++) sum_2 += sink_2.pop().data[0]; });
+
+  Stopwatch sw;
+  Frame frame;
+  for (size_t i = 0; i < NUM_FRAMES; i++)
+  {
+    memset(frame.data, static_cast<int>(i), sizeof(frame.data));
+    source.push(frame);
+  }
+  consumer_1.join();
+  consumer_2.join();
+
+  report("Source -> 2 x SinkBlocking (512 byte frame)", NUM_FRAMES, sw.elapsed_s());
+}
+
+static void benchmark_frame_loan()
+{
+  LoanSource<Frame, 10> source;
+  SinkBlocking<Slot<Frame>, 4> sink_1, sink_2;
+  source.connectTo(sink_1);
+  source.connectTo(sink_2);
+
+  rtos::Thread consumer_1, consumer_2;
+  volatile long sum_1 = 0, sum_2 = 0; /* One per consumer, they run concurrently. */
+  consumer_1.start([&]() { for (size_t i = 0; i < NUM_FRAMES; i++) sum_1 += sink_1.pop()->data[0]; });
+  consumer_2.start([&]() { for (size_t i = 0; i < NUM_FRAMES; i++) sum_2 += sink_2.pop()->data[0]; });
+
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_FRAMES; i++)
+  {
+    auto frame = source.loan();
+    memset(frame->data, static_cast<int>(i), sizeof(frame->data));
+    frame.publish();
+  }
+  consumer_1.join();
+  consumer_2.join();
+
+  report("LoanSource -> 2 x SinkBlocking (512 byte frame)", NUM_FRAMES, sw.elapsed_s());
+}
+
+static void benchmark_fan_out()
+{
+  /* No consumers: the overwriting sinks never block, so only
+   * the cost of distributing a value to 4 sinks is measured.
+   */
+  typedef SinkBlocking<int, 1, SinkOverflowPolicy::Overwrite> SinkType;
+  SinkType sink_1, sink_2, sink_3, sink_4;
+
+  {
+    Source<int> source;
+    source.connectTo(sink_1);
+    source.connectTo(sink_2);
+    source.connectTo(sink_3);
+    source.connectTo(sink_4);
+
+    Stopwatch sw;
+    for (size_t i = 0; i < NUM_SAMPLES; i++)
+      source.push(static_cast<int>(i));
+    report("Source -> 4 x SinkBlocking (fan-out)", NUM_SAMPLES, sw.elapsed_s());
+  }
+  {
+    StaticSource<int, SinkType, SinkType, SinkType, SinkType> source(sink_1, sink_2, sink_3, sink_4);
+
+    Stopwatch sw;
+    for (size_t i = 0; i < NUM_SAMPLES; i++)
+      source.push(static_cast<int>(i));
+    report("StaticSource -> 4 x SinkBlocking (fan-out)", NUM_SAMPLES, sw.elapsed_s());
+  }
+}
+
+static void benchmark_shared()
+{
+  Shared<int> shared;
+
+  /* Shared<T>::push() on a full queue discards the oldest element. */
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_SAMPLES; i++)
+    shared.push(static_cast<int>(i));
+
+  report("Shared<int>::push (queue full)", NUM_SAMPLES, sw.elapsed_s());
+}
+
+struct Config
+{
+  int32_t gain;
+  int32_t offset;
+  int32_t checksum;
+};
+
+static void benchmark_shared_latest()
+{
+  SharedLatest<Config> shared;
+  std::atomic<bool> done{false};
+  std::atomic<size_t> num_torn{0};
+
+  rtos::Thread reader;
+  reader.start([&]()
+  {
+    while (!done)
+    {
+      Config const config = shared.peek();
+      if ((config.gain + config.offset) != config.checksum)
+        num_torn++;
+    }
+  });
+
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_SAMPLES; i++)
+  {
+    int32_t const v = static_cast<int32_t>(i);
+    shared.push(Config{v, 2 * v, 3 * v});
+  }
+  double const elapsed_s = sw.elapsed_s();
+  done = true;
+  reader.join();
+
+  report("SharedLatest<Config>::push (concurrent reader)", NUM_SAMPLES, elapsed_s);
+  printf("  torn reads: %zu\n", num_torn.load());
+}
+
+/**************************************************************************************
+ * MAIN
+ **************************************************************************************/
+
+int main()
+{
+  {
+    SinkBlocking<int, 1> sink;
+    benchmark_source_sink("Source -> SinkBlocking (size 1)", sink);
+  }
+  {
+    SinkBlocking<int, 16> sink;
+    benchmark_source_sink("Source -> SinkBlocking (size 16)", sink);
+  }
+  {
+    SinkSpsc<int, 1> sink;
+    benchmark_source_sink("Source -> SinkSpsc (size 1)", sink);
+  }
+  {
+    SinkSpsc<int, 16> sink;
+    benchmark_source_sink("Source -> SinkSpsc (size 16)", sink);
+  }
+  {
+    SinkBlocking<int, 16> sink;
+    benchmark_source_sink_batch("Source -> SinkBlocking (size 16, batches of 16)", sink);
+  }
+  {
+    SinkSpsc<int, 16> sink;
+    benchmark_source_sink_batch("Source -> SinkSpsc (size 16, batches of 16)", sink);
+  }
+  benchmark_fan_out();
+  benchmark_frame_copy();
+  benchmark_frame_loan();
+  benchmark_shared();
+  benchmark_shared_latest();
+  return 0;
+}
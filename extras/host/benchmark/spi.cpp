@@ -0,0 +1,224 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino_Threads.h>
+#include <io/spi/SpiDispatcher.h>
+
+#include <atomic>
+
+#include "benchmark.h"
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+static size_t constexpr NUM_TRANSFERS = 20000;
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+static void benchmark_transfer_and_wait(size_t const len)
+{
+  BusDevice dev(SPI, 10, 1000000, MSBFIRST, SPI_MODE0);
+
+  byte write_buf[4096] = {0};
+  byte read_buf[4096] = {0};
+
+  size_t const bus_calls_before = SpiDispatcher::instance(SPI).busCalls();
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_TRANSFERS; i++)
+  {
+    IoRequest req(write_buf, 1, read_buf, len);
+    transferAndWait(dev, req);
+  }
+
+  char name[64];
+  snprintf(name, sizeof(name), "SPI transferAndWait (1 + %zu bytes)", len);
+  report(name, NUM_TRANSFERS, sw.elapsed_s());
+  size_t const bus_calls = SpiDispatcher::instance(SPI).busCalls() - bus_calls_before;
+  printf("%-48s %10.1f bus calls/transfer\n", "", static_cast<double>(bus_calls) / NUM_TRANSFERS);
+}
+
+static void benchmark_sync_result(bool const on_stack)
+{
+  BusDevice dev(SPI, 10, 1000000, MSBFIRST, SPI_MODE0);
+
+  byte write_buf[1] = {0};
+  byte read_buf[4] = {0};
+
+  size_t const allocations_before = SpiDispatcher::instance(SPI).responseAllocations();
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_TRANSFERS; i++)
+  {
+    IoRequest req(write_buf, 1, read_buf, sizeof(read_buf));
+    if (on_stack)
+    {
+      IoResult result;
+      transferAndWait(dev, req, result);
+    }
+    else
+      transferAndWait(dev, req);
+  }
+
+  report(on_stack ? "SPI transferAndWait (result on stack)" : "SPI transferAndWait (pooled response)", NUM_TRANSFERS, sw.elapsed_s());
+  size_t const allocations = SpiDispatcher::instance(SPI).responseAllocations() - allocations_before;
+  printf("%-48s %10.1f response allocations/transfer\n", "", static_cast<double>(allocations) / NUM_TRANSFERS);
+}
+
+static void benchmark_concurrent_writeThenRead(size_t const num_threads)
+{
+  BusDevice dev(SPI, 10, 1000000, MSBFIRST, SPI_MODE0);
+
+  rtos::Thread threads[8];
+  size_t const bus_calls_before = SpiDispatcher::instance(SPI).busCalls();
+  Stopwatch sw;
+  for (size_t t = 0; t < num_threads; t++)
+    threads[t].start([&dev]()
+    {
+      byte write_buf[2] = {0x01, 0x02};
+      byte read_buf[4] = {0};
+      for (size_t i = 0; i < NUM_TRANSFERS; i++)
+        dev.spi().writeThenRead(write_buf, sizeof(write_buf), read_buf, sizeof(read_buf));
+    });
+  for (size_t t = 0; t < num_threads; t++)
+    threads[t].join();
+
+  char name[64];
+  snprintf(name, sizeof(name), "SPI writeThenRead (%zu threads)", num_threads);
+  report(name, NUM_TRANSFERS * num_threads, sw.elapsed_s());
+  size_t const bus_calls = SpiDispatcher::instance(SPI).busCalls() - bus_calls_before;
+  printf("%-48s %10.1f bus calls/transfer\n", "", static_cast<double>(bus_calls) / (NUM_TRANSFERS * num_threads));
+}
+
+static void benchmark_two_busses()
+{
+  BusDevice dev0(SPI,  10, 1000000, MSBFIRST, SPI_MODE0);
+  BusDevice dev1(SPI1, 11, 1000000, MSBFIRST, SPI_MODE0);
+
+  /* Each bus is served by its own dispatcher thread. */
+  size_t const bus_calls_before_0 = SpiDispatcher::instance(SPI).busCalls();
+  size_t const bus_calls_before_1 = SpiDispatcher::instance(SPI1).busCalls();
+
+  auto const client = [](BusDevice & dev)
+  {
+    byte write_buf[2] = {0x01, 0x02};
+    byte read_buf[4] = {0};
+    for (size_t i = 0; i < NUM_TRANSFERS; i++)
+      dev.spi().writeThenRead(write_buf, sizeof(write_buf), read_buf, sizeof(read_buf));
+  };
+
+  rtos::Thread thread0, thread1;
+  Stopwatch sw;
+  thread0.start([&]() { client(dev0); });
+  thread1.start([&]() { client(dev1); });
+  thread0.join();
+  thread1.join();
+
+  report("SPI writeThenRead (SPI + SPI1, 1 thread each)", 2 * NUM_TRANSFERS, sw.elapsed_s());
+  size_t const bus_calls_0 = SpiDispatcher::instance(SPI).busCalls() - bus_calls_before_0;
+  size_t const bus_calls_1 = SpiDispatcher::instance(SPI1).busCalls() - bus_calls_before_1;
+  printf("%-48s %10.1f / %.1f bus calls/transfer (SPI / SPI1)\n", "",
+         static_cast<double>(bus_calls_0) / NUM_TRANSFERS,
+         static_cast<double>(bus_calls_1) / NUM_TRANSFERS);
+}
+
+static void benchmark_deadline_missed()
+{
+  BusDevice dev(SPI, 10, 1000000, MSBFIRST, SPI_MODE0);
+
+  byte write_buf[1] = {0};
+  byte read_buf[4] = {0};
+
+  /* Requests whose deadline has already passed are discarded
+   * without accessing the bus and must not report success.
+   */
+  size_t const bus_calls_before = SpiDispatcher::instance(SPI).busCalls();
+  size_t num_missed = 0;
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_TRANSFERS; i++)
+  {
+    IoRequest req(write_buf, 1, read_buf, sizeof(read_buf));
+    req.deadline = rtos::Kernel::Clock::now() - std::chrono::milliseconds(1);
+    IoResult result;
+    if (transferAndWait(dev, req, result) == IoStatus::DeadlineMissed)
+      num_missed++;
+  }
+
+  report("SPI transferAndWait (deadline missed)", NUM_TRANSFERS, sw.elapsed_s());
+  size_t const bus_calls = SpiDispatcher::instance(SPI).busCalls() - bus_calls_before;
+  printf("%-48s %10zu of %zu missed, %zu bus calls\n", "", num_missed, NUM_TRANSFERS, bus_calls);
+}
+
+static void benchmark_async_burst()
+{
+  static size_t constexpr BURST_SIZE = 4;
+
+  BusDevice dev(SPI, 10, 1000000, MSBFIRST, SPI_MODE0);
+
+  byte write_buf[1] = {0};
+  byte read_buf[BURST_SIZE][4] = {{0}};
+  IoRequest req[BURST_SIZE] = {{write_buf, 1, read_buf[0], 4},
+                               {write_buf, 1, read_buf[1], 4},
+                               {write_buf, 1, read_buf[2], 4},
+                               {write_buf, 1, read_buf[3], 4}};
+
+  /* Back-to-back requests are executed without deasserting the chip select. */
+  dev.spi().setKeepCsAsserted(true);
+
+  std::atomic<size_t> num_completed{0};
+  IoCompletionCallback const on_complete = [&num_completed](IoResponse const &) { num_completed++; };
+
+  size_t const bus_calls_before = SpiDispatcher::instance(SPI).busCalls();
+  Stopwatch sw;
+  for (size_t i = 0; i < NUM_TRANSFERS; i += BURST_SIZE)
+  {
+    IoResponse rsp[BURST_SIZE];
+    for (size_t b = 0; b < BURST_SIZE; b++)
+      rsp[b] = dev.transfer(req[b], on_complete);
+    /* Requests are processed in order. */
+    rsp[BURST_SIZE - 1]->wait();
+  }
+
+  report("SPI transfer with callback (bursts of 4)", NUM_TRANSFERS, sw.elapsed_s());
+  size_t const bus_calls = SpiDispatcher::instance(SPI).busCalls() - bus_calls_before;
+  printf("%-48s %10.1f bus calls/transfer\n", "", static_cast<double>(bus_calls) / NUM_TRANSFERS);
+  printf("%-48s %10zu completions\n", "", num_completed.load());
+}
+
+/**************************************************************************************
+ * MAIN
+ **************************************************************************************/
+
+int main()
+{
+  benchmark_transfer_and_wait(4);
+  benchmark_transfer_and_wait(4096);
+  benchmark_sync_result(false);
+  benchmark_sync_result(true);
+  benchmark_concurrent_writeThenRead(1);
+  benchmark_concurrent_writeThenRead(4);
+  benchmark_two_busses();
+  benchmark_deadline_missed();
+  benchmark_async_burst();
+  return 0;
+}
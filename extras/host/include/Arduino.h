@@ -0,0 +1,45 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_ARDUINO_H_
+#define ARDUINO_THREADS_HOST_ARDUINO_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+/* Host replacement for the ArduinoCore-API / ArduinoCore-mbed <Arduino.h>. */
+
+#include "api/Common.h"
+#include "api/String.h"
+#include "api/Print.h"
+#include "api/Stream.h"
+#include "api/RingBuffer.h"
+#include "api/HardwareSerial.h"
+#include "api/HardwareSPI.h"
+#include "api/HardwareI2C.h"
+
+#include "HostSerial.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+using namespace arduino;
+
+#endif /* ARDUINO_THREADS_HOST_ARDUINO_H_ */
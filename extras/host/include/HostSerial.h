@@ -0,0 +1,93 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_HOSTSERIAL_H_
+#define ARDUINO_THREADS_HOST_HOSTSERIAL_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+
+#include "api/HardwareSerial.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Mock UART: transmitted bytes are counted and optionally echoed to
+ * stdout, received bytes are supplied by the host program via inject().
+ */
+class HostSerial : public HardwareSerial
+{
+public:
+
+  HostSerial(const char * name);
+
+  virtual void begin(unsigned long baudrate) override;
+  virtual void begin(unsigned long baudrate, uint16_t config) override;
+  virtual void end() override;
+  virtual int available() override;
+  virtual int peek() override;
+  virtual int read() override;
+  virtual void flush() override;
+  virtual size_t write(uint8_t const b) override;
+  virtual size_t write(const uint8_t * data, size_t len) override;
+  using Print::write;
+  virtual operator bool() override { return _is_open; }
+
+  void setEcho(bool const echo) { _echo = echo; }
+  void inject(const uint8_t * data, size_t len);
+
+  size_t bytesWritten() const { return _bytes_written; }
+  size_t writeCalls() const { return _write_calls; }
+  void resetStatistics() { _bytes_written = 0; _write_calls = 0; }
+
+
+private:
+
+  const char * _name;
+  std::atomic<bool> _is_open;
+  std::atomic<bool> _echo;
+  std::mutex _rx_mutex;
+  std::deque<uint8_t> _rx_data;
+  std::atomic<size_t> _bytes_written;
+  std::atomic<size_t> _write_calls;
+
+};
+
+} /* namespace arduino */
+
+/**************************************************************************************
+ * EXTERN DECLARATION
+ **************************************************************************************/
+
+extern arduino::HostSerial SerialUSB;
+extern arduino::HostSerial Serial1;
+
+#endif /* ARDUINO_THREADS_HOST_HOSTSERIAL_H_ */
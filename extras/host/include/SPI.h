@@ -0,0 +1,89 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_SPI_H_
+#define ARDUINO_THREADS_HOST_SPI_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+
+#include "Arduino.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Mock SPI controller with MISO looped back to MOSI. Every call which
+ * would reach the SPI peripheral is counted so that the bus overhead of
+ * the dispatcher can be evaluated on the host.
+ */
+class HostSPI : public HardwareSPI
+{
+public:
+
+  HostSPI();
+
+  virtual uint8_t transfer(uint8_t data) override;
+  virtual uint16_t transfer16(uint16_t data) override;
+  virtual void transfer(void * buf, size_t count) override;
+
+  virtual void usingInterrupt(int) override { }
+  virtual void notUsingInterrupt(int) override { }
+  virtual void beginTransaction(SPISettings settings) override;
+  virtual void endTransaction(void) override;
+
+  virtual void attachInterrupt() override { }
+  virtual void detachInterrupt() override { }
+
+  virtual void begin() override;
+  virtual void end() override;
+
+  size_t transferCalls() const { return _transfer_calls; }
+  size_t bytesTransferred() const { return _bytes_transferred; }
+  size_t beginTransactionCalls() const { return _begin_transaction_calls; }
+  void resetStatistics();
+
+
+private:
+
+  std::atomic<size_t> _transfer_calls;
+  std::atomic<size_t> _bytes_transferred;
+  std::atomic<size_t> _begin_transaction_calls;
+
+};
+
+} /* namespace arduino */
+
+/**************************************************************************************
+ * EXTERN DECLARATION
+ **************************************************************************************/
+
+extern arduino::HostSPI SPI;
+extern arduino::HostSPI SPI1;
+
+#endif /* ARDUINO_THREADS_HOST_SPI_H_ */
@@ -0,0 +1,151 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_SHAREDPTR_H_
+#define ARDUINO_THREADS_HOST_SHAREDPTR_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace mbed
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Reference counted pointer with the same semantics as mbed::SharedPtr,
+ * including the separately heap allocated counter and the use of plain
+ * 'delete' for the managed object.
+ */
+template <class T>
+class SharedPtr
+{
+public:
+
+  constexpr SharedPtr() : _ptr{nullptr}, _counter{nullptr} { }
+  constexpr SharedPtr(std::nullptr_t) : SharedPtr() { }
+
+  SharedPtr(T * ptr) : _ptr{ptr}, _counter{nullptr}
+  {
+    if (_ptr != nullptr)
+      _counter = new std::atomic<uint32_t>{1};
+  }
+
+  SharedPtr(SharedPtr const & source) : _ptr{source._ptr}, _counter{source._counter}
+  {
+    if (_ptr != nullptr)
+      _counter->fetch_add(1);
+  }
+
+  SharedPtr(SharedPtr && source) : _ptr{source._ptr}, _counter{source._counter}
+  {
+    source._ptr = nullptr;
+    source._counter = nullptr;
+  }
+
+  ~SharedPtr()
+  {
+    decrement_counter();
+  }
+
+  SharedPtr & operator = (SharedPtr const & source)
+  {
+    if (this != &source)
+    {
+      decrement_counter();
+      _ptr = source._ptr;
+      _counter = source._counter;
+      if (_ptr != nullptr)
+        _counter->fetch_add(1);
+    }
+    return *this;
+  }
+
+  SharedPtr & operator = (SharedPtr && source)
+  {
+    if (this != &source)
+    {
+      decrement_counter();
+      _ptr = source._ptr;
+      _counter = source._counter;
+      source._ptr = nullptr;
+      source._counter = nullptr;
+    }
+    return *this;
+  }
+
+  void reset(T * ptr = nullptr)
+  {
+    decrement_counter();
+    _ptr = ptr;
+    _counter = (_ptr != nullptr) ? new std::atomic<uint32_t>{1} : nullptr;
+  }
+
+  T * get() const { return _ptr; }
+  uint32_t use_count() const { return (_ptr != nullptr) ? _counter->load() : 0; }
+
+  T & operator * () const { return *_ptr; }
+  T * operator -> () const { return _ptr; }
+  explicit operator bool() const { return (_ptr != nullptr); }
+
+
+private:
+
+  T * _ptr;
+  std::atomic<uint32_t> * _counter;
+
+  void decrement_counter()
+  {
+    if (_ptr != nullptr)
+    {
+      if (_counter->fetch_sub(1) == 1)
+      {
+        delete _counter;
+        delete _ptr;
+      }
+    }
+  }
+
+};
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+template<class T, class U>
+bool operator == (SharedPtr<T> const & lhs, SharedPtr<U> const & rhs) { return (lhs.get() == rhs.get()); }
+template<class T, typename U>
+bool operator == (SharedPtr<T> const & lhs, U rhs) { return (lhs.get() == static_cast<T *>(rhs)); }
+template<class T, class U>
+bool operator != (SharedPtr<T> const & lhs, SharedPtr<U> const & rhs) { return (lhs.get() != rhs.get()); }
+template<class T, typename U>
+bool operator != (SharedPtr<T> const & lhs, U rhs) { return (lhs.get() != static_cast<T *>(rhs)); }
+
+} /* namespace mbed */
+
+#endif /* ARDUINO_THREADS_HOST_SHAREDPTR_H_ */
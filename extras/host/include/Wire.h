@@ -0,0 +1,105 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_WIRE_H_
+#define ARDUINO_THREADS_HOST_WIRE_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+
+#include "Arduino.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Mock I2C controller. Every slave address answers as a simple register
+ * file device: the first byte of a write sets the register pointer, any
+ * further bytes are stored at auto-incrementing register addresses and
+ * reads return data starting at the current register pointer.
+ */
+class HostI2C : public HardwareI2C
+{
+public:
+
+  HostI2C();
+
+  virtual void begin() override;
+  virtual void begin(uint8_t) override { begin(); }
+  virtual void end() override;
+
+  virtual void setClock(uint32_t) override { }
+
+  virtual void beginTransmission(uint8_t address) override;
+  virtual uint8_t endTransmission(bool stopBit) override;
+  virtual uint8_t endTransmission(void) override { return endTransmission(true); }
+
+  virtual size_t requestFrom(uint8_t address, size_t len, bool stopBit) override;
+  virtual size_t requestFrom(uint8_t address, size_t len) override { return requestFrom(address, len, true); }
+
+  virtual void onReceive(void(*)(int)) override { }
+  virtual void onRequest(void(*)(void)) override { }
+
+  virtual size_t write(uint8_t data) override;
+  using Print::write;
+  virtual int available() override;
+  virtual int read() override;
+  virtual int peek() override;
+
+  size_t transactions() const { return _transactions; }
+  void resetStatistics() { _transactions = 0; }
+
+
+private:
+
+  static size_t constexpr BUFFER_SIZE = 256;
+
+  uint8_t _registers[128][BUFFER_SIZE];
+  uint8_t _register_ptr[128];
+
+  uint8_t _tx_address;
+  uint8_t _tx_buf[BUFFER_SIZE];
+  size_t _tx_len;
+
+  uint8_t _rx_buf[BUFFER_SIZE];
+  size_t _rx_len, _rx_idx;
+
+  std::atomic<size_t> _transactions;
+
+};
+
+} /* namespace arduino */
+
+/**************************************************************************************
+ * EXTERN DECLARATION
+ **************************************************************************************/
+
+extern arduino::HostI2C Wire;
+extern arduino::HostI2C Wire1;
+
+#endif /* ARDUINO_THREADS_HOST_WIRE_H_ */
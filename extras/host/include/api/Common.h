@@ -0,0 +1,73 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_API_COMMON_H_
+#define ARDUINO_THREADS_HOST_API_COMMON_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <cstdint>
+#include <cstddef>
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint8_t pin_size_t;
+
+typedef enum
+{
+  LOW     = 0,
+  HIGH    = 1,
+  CHANGE  = 2,
+  FALLING = 3,
+  RISING  = 4,
+} PinStatus;
+
+typedef enum
+{
+  INPUT          = 0x0,
+  OUTPUT         = 0x1,
+  INPUT_PULLUP   = 0x2,
+  INPUT_PULLDOWN = 0x3,
+} PinMode;
+
+typedef enum
+{
+  LSBFIRST = 0,
+  MSBFIRST = 1,
+} BitOrder;
+
+/**************************************************************************************
+ * FUNCTION DECLARATION
+ **************************************************************************************/
+
+void pinMode(pin_size_t pin, PinMode mode);
+void digitalWrite(pin_size_t pin, PinStatus val);
+PinStatus digitalRead(pin_size_t pin);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+#endif /* ARDUINO_THREADS_HOST_API_COMMON_H_ */
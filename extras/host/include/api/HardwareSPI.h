@@ -0,0 +1,106 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_API_HARDWARESPI_H_
+#define ARDUINO_THREADS_HOST_API_HARDWARESPI_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "Common.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+typedef enum
+{
+  SPI_MODE0 = 0,
+  SPI_MODE1 = 1,
+  SPI_MODE2 = 2,
+  SPI_MODE3 = 3,
+} SPIMode;
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+class SPISettings
+{
+public:
+
+  SPISettings(uint32_t clock, BitOrder bitOrder, SPIMode dataMode)
+  : clockFreq{clock}
+  , bitOrder{bitOrder}
+  , dataMode{dataMode}
+  { }
+
+  SPISettings() : SPISettings(4000000, MSBFIRST, SPI_MODE0) { }
+
+  bool operator == (SPISettings const & rhs) const
+  {
+    return (clockFreq == rhs.clockFreq) && (bitOrder == rhs.bitOrder) && (dataMode == rhs.dataMode);
+  }
+  bool operator != (SPISettings const & rhs) const { return !(*this == rhs); }
+
+  uint32_t getClockFreq() const { return clockFreq; }
+  SPIMode getDataMode() const { return dataMode; }
+  BitOrder getBitOrder() const { return bitOrder; }
+
+
+private:
+
+  uint32_t clockFreq;
+  BitOrder bitOrder;
+  SPIMode dataMode;
+
+};
+
+class HardwareSPI
+{
+public:
+
+  virtual ~HardwareSPI() { }
+
+  virtual uint8_t transfer(uint8_t data) = 0;
+  virtual uint16_t transfer16(uint16_t data) = 0;
+  virtual void transfer(void * buf, size_t count) = 0;
+
+  virtual void usingInterrupt(int interruptNumber) = 0;
+  virtual void notUsingInterrupt(int interruptNumber) = 0;
+  virtual void beginTransaction(SPISettings settings) = 0;
+  virtual void endTransaction(void) = 0;
+
+  virtual void attachInterrupt() = 0;
+  virtual void detachInterrupt() = 0;
+
+  virtual void begin() = 0;
+  virtual void end() = 0;
+};
+
+} /* namespace arduino */
+
+#endif /* ARDUINO_THREADS_HOST_API_HARDWARESPI_H_ */
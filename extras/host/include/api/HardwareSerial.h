@@ -0,0 +1,69 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_API_HARDWARESERIAL_H_
+#define ARDUINO_THREADS_HOST_API_HARDWARESERIAL_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "Common.h"
+#include "Stream.h"
+#include "RingBuffer.h"
+
+/**************************************************************************************
+ * DEFINE
+ **************************************************************************************/
+
+#define SERIAL_PARITY_NONE   (0x1ul)
+#define SERIAL_STOP_BIT_1    (0x10ul)
+#define SERIAL_DATA_8        (0x400ul)
+
+#define SERIAL_8N1           (SERIAL_STOP_BIT_1 | SERIAL_PARITY_NONE | SERIAL_DATA_8)
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+class HardwareSerial : public Stream
+{
+public:
+
+  virtual void begin(unsigned long) = 0;
+  virtual void begin(unsigned long baudrate, uint16_t config) = 0;
+  virtual void end() = 0;
+  virtual int available(void) = 0;
+  virtual int peek(void) = 0;
+  virtual int read(void) = 0;
+  virtual void flush(void) = 0;
+  virtual size_t write(uint8_t) = 0;
+  using Print::write;
+  virtual operator bool() = 0;
+};
+
+} /* namespace arduino */
+
+#endif /* ARDUINO_THREADS_HOST_API_HARDWARESERIAL_H_ */
@@ -0,0 +1,102 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_API_PRINT_H_
+#define ARDUINO_THREADS_HOST_API_PRINT_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#include "Common.h"
+#include "String.h"
+
+/**************************************************************************************
+ * DEFINE
+ **************************************************************************************/
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+class Print
+{
+public:
+
+  virtual ~Print() { }
+
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t * buffer, size_t size)
+  {
+    size_t n = 0;
+    while (size--) {
+      if (write(*buffer++)) n++;
+      else break;
+    }
+    return n;
+  }
+  size_t write(const char * str) { return (str == nullptr) ? 0 : write(reinterpret_cast<const uint8_t *>(str), strlen(str)); }
+  size_t write(const char * buffer, size_t size) { return write(reinterpret_cast<const uint8_t *>(buffer), size); }
+
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() { }
+
+  size_t print(String const & s) { return write(s.c_str(), s.length()); }
+  size_t print(const char str[]) { return write(str); }
+  size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+  size_t print(int n, int base = DEC) { return print(static_cast<long>(n), base); }
+  size_t print(unsigned int n, int base = DEC) { return print(static_cast<unsigned long>(n), base); }
+  size_t print(long n, int base = DEC) { return printFormatted((base == HEX) ? "%lX" : "%ld", n); }
+  size_t print(unsigned long n, int base = DEC) { return printFormatted((base == HEX) ? "%lX" : "%lu", n); }
+  size_t print(double n, int digits = 2) { char fmt[8]; snprintf(fmt, sizeof(fmt), "%%.%df", digits); return printFormatted(fmt, n); }
+
+  size_t println() { return write("\r\n"); }
+  template <typename T> size_t println(T const & val) { size_t n = print(val); return n + println(); }
+  template <typename T> size_t println(T const & val, int fmt) { size_t n = print(val, fmt); return n + println(); }
+
+
+private:
+
+  template <typename T>
+  size_t printFormatted(const char * fmt, T const val)
+  {
+    char buf[32];
+    int const len = snprintf(buf, sizeof(buf), fmt, val);
+    return (len > 0) ? write(buf, static_cast<size_t>(len)) : 0;
+  }
+
+};
+
+} /* namespace arduino */
+
+#endif /* ARDUINO_THREADS_HOST_API_PRINT_H_ */
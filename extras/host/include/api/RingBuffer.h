@@ -0,0 +1,97 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_API_RINGBUFFER_H_
+#define ARDUINO_THREADS_HOST_API_RINGBUFFER_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <cstdint>
+#include <cstring>
+
+/**************************************************************************************
+ * DEFINE
+ **************************************************************************************/
+
+#define SERIAL_BUFFER_SIZE 64
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+template <int N>
+class RingBufferN
+{
+public:
+
+  uint8_t _aucBuffer[N];
+
+  RingBufferN() { memset(_aucBuffer, 0, N); clear(); }
+
+  void store_char(uint8_t c)
+  {
+    if (!isFull()) {
+      _aucBuffer[_iHead] = c;
+      _iHead = nextIndex(_iHead);
+      _numElems++;
+    }
+  }
+
+  void clear() { _iHead = 0; _iTail = 0; _numElems = 0; }
+
+  int read_char()
+  {
+    if (isEmpty())
+      return -1;
+    uint8_t const value = _aucBuffer[_iTail];
+    _iTail = nextIndex(_iTail);
+    _numElems--;
+    return value;
+  }
+
+  int available() { return _numElems; }
+  int availableForStore() { return (N - _numElems); }
+  int peek() { return isEmpty() ? -1 : _aucBuffer[_iTail]; }
+  bool isFull() { return (_numElems == N); }
+
+
+private:
+
+  int _iHead;
+  int _iTail;
+  int _numElems;
+
+  int nextIndex(int index) { return static_cast<uint32_t>(index + 1) % N; }
+  bool isEmpty() { return (_numElems == 0); }
+
+};
+
+typedef RingBufferN<SERIAL_BUFFER_SIZE> RingBuffer;
+
+} /* namespace arduino */
+
+#endif /* ARDUINO_THREADS_HOST_API_RINGBUFFER_H_ */
@@ -0,0 +1,85 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_API_STREAM_H_
+#define ARDUINO_THREADS_HOST_API_STREAM_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "Common.h"
+#include "Print.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+class Stream : public Print
+{
+public:
+
+  Stream() : _timeout{1000} { }
+
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long timeout) { _timeout = timeout; }
+  unsigned long getTimeout() { return _timeout; }
+
+  virtual size_t readBytes(char * buffer, size_t length)
+  {
+    size_t count = 0;
+    while (count < length) {
+      int const c = timedRead();
+      if (c < 0) break;
+      *buffer++ = static_cast<char>(c);
+      count++;
+    }
+    return count;
+  }
+  size_t readBytes(uint8_t * buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+
+
+protected:
+
+  unsigned long _timeout;
+
+  int timedRead()
+  {
+    unsigned long const start = millis();
+    do {
+      int const c = read();
+      if (c >= 0) return c;
+    } while ((millis() - start) < _timeout);
+    return -1;
+  }
+
+};
+
+} /* namespace arduino */
+
+#endif /* ARDUINO_THREADS_HOST_API_STREAM_H_ */
@@ -0,0 +1,95 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_API_STRING_H_
+#define ARDUINO_THREADS_HOST_API_STRING_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <string>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Heap backed string with the subset of the Arduino String interface used
+ * by the library. Like the Arduino String it reallocates as it grows, which
+ * keeps allocation profiles taken on the host representative.
+ */
+class String
+{
+public:
+
+  String(const char * cstr = "") : _str{cstr ? cstr : ""} { }
+  String(const char * cstr, unsigned int length) : _str{cstr, length} { }
+  explicit String(char c) : _str(1, c) { }
+  explicit String(int value) : _str{std::to_string(value)} { }
+  explicit String(unsigned int value) : _str{std::to_string(value)} { }
+  explicit String(long value) : _str{std::to_string(value)} { }
+  explicit String(unsigned long value) : _str{std::to_string(value)} { }
+
+  unsigned int length() const { return static_cast<unsigned int>(_str.length()); }
+  const char * c_str() const { return _str.c_str(); }
+  bool reserve(unsigned int size) { _str.reserve(size); return true; }
+
+  bool concat(String const & str) { _str += str._str; return true; }
+  bool concat(const char * cstr) { _str += cstr; return true; }
+  bool concat(const char * cstr, unsigned int length) { _str.append(cstr, length); return true; }
+  bool concat(char c) { _str += c; return true; }
+
+  String & operator += (String const & rhs) { concat(rhs); return *this; }
+  String & operator += (const char * cstr) { concat(cstr); return *this; }
+  String & operator += (char c) { concat(c); return *this; }
+
+  char operator [] (unsigned int index) const { return (index < _str.length()) ? _str[index] : 0; }
+  bool operator == (String const & rhs) const { return (_str == rhs._str); }
+  bool operator != (String const & rhs) const { return (_str != rhs._str); }
+
+
+private:
+
+  std::string _str;
+
+};
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+inline String operator + (String const & lhs, String const & rhs) { String s(lhs); s += rhs; return s; }
+inline String operator + (String const & lhs, const char * rhs) { String s(lhs); s += rhs; return s; }
+inline String operator + (String const & lhs, char rhs) { String s(lhs); s += rhs; return s; }
+
+} /* namespace arduino */
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+using arduino::String;
+
+#endif /* ARDUINO_THREADS_HOST_API_STRING_H_ */
@@ -0,0 +1,88 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_CMSIS_OS2_H_
+#define ARDUINO_THREADS_HOST_CMSIS_OS2_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <cstdint>
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+/* Only the subset of the CMSIS-RTOS2 API which is referenced
+ * by the library or by the host rtos backend is provided here.
+ */
+
+typedef void * osThreadId_t;
+
+typedef enum
+{
+  osPriorityNone         =  0,
+  osPriorityIdle         =  1,
+  osPriorityLow          =  8,
+  osPriorityBelowNormal  = 16,
+  osPriorityNormal       = 24,
+  osPriorityAboveNormal  = 32,
+  osPriorityHigh         = 40,
+  osPriorityRealtime     = 48,
+  osPriorityISR          = 56,
+  osPriorityError        = -1,
+} osPriority_t;
+
+typedef osPriority_t osPriority;
+
+typedef enum
+{
+  osOK                   =  0,
+  osError                = -1,
+  osErrorTimeout         = -2,
+  osErrorResource        = -3,
+  osErrorParameter       = -4,
+  osErrorNoMemory        = -5,
+  osErrorISR             = -6,
+} osStatus_t;
+
+typedef osStatus_t osStatus;
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+static uint32_t constexpr osWaitForever       = 0xFFFFFFFFU;
+
+static uint32_t constexpr osFlagsWaitAny      = 0x00000000U;
+static uint32_t constexpr osFlagsWaitAll      = 0x00000001U;
+static uint32_t constexpr osFlagsNoClear      = 0x00000002U;
+
+static uint32_t constexpr osFlagsError          = 0x80000000U;
+static uint32_t constexpr osFlagsErrorUnknown   = 0xFFFFFFFFU;
+static uint32_t constexpr osFlagsErrorTimeout   = 0xFFFFFFFEU;
+static uint32_t constexpr osFlagsErrorParameter = 0xFFFFFFFCU;
+
+/**************************************************************************************
+ * FUNCTION DECLARATION
+ **************************************************************************************/
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+
+#endif /* ARDUINO_THREADS_HOST_CMSIS_OS2_H_ */
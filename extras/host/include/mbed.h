@@ -0,0 +1,61 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_MBED_H_
+#define ARDUINO_THREADS_HOST_MBED_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+/* Host (POSIX) replacement for <mbed.h> providing exactly the subset
+ * of the Mbed OS platform and rtos API used by Arduino_Threads.
+ */
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+
+#include "cmsis_os2.h"
+
+#include "platform/mbed_atomic.h"
+#include "platform/mbed_critical.h"
+#include "platform/Callback.h"
+#include "platform/ScopedLock.h"
+
+#include "rtos/Kernel.h"
+#include "rtos/Mutex.h"
+#include "rtos/ConditionVariable.h"
+#include "rtos/EventFlags.h"
+#include "rtos/Thread.h"
+#include "rtos/ThisThread.h"
+#include "rtos/Mail.h"
+
+/**************************************************************************************
+ * DEFINE
+ **************************************************************************************/
+
+#ifndef MBED_ASSERT
+# define MBED_ASSERT(expr) assert(expr)
+#endif
+
+#endif /* ARDUINO_THREADS_HOST_MBED_H_ */
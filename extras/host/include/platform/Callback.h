@@ -0,0 +1,101 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_PLATFORM_CALLBACK_H_
+#define ARDUINO_THREADS_HOST_PLATFORM_CALLBACK_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace mbed
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+template <typename Signature>
+class Callback;
+
+template <typename R, typename... Args>
+class Callback<R(Args...)>
+{
+public:
+
+  Callback() : _func{nullptr} { }
+  Callback(std::nullptr_t) : _func{nullptr} { }
+  Callback(R (*func)(Args...)) : _func{func} { }
+
+  /* Like on the target functors are restricted to what mbed::Callback
+   * can store in place: trivially copyable and no larger than an object
+   * pointer plus a member function pointer.
+   */
+  template <typename F>
+  Callback(F f) : _func{f}
+  {
+    static_assert(sizeof(F) <= FUNCTOR_STORAGE_SIZE, "mbed::Callback: functor too large for the target's mbed::Callback");
+    static_assert(std::is_trivially_copyable<F>::value, "mbed::Callback: functor must be trivially copyable on the target");
+  }
+
+  template <typename T, typename U>
+  Callback(U * obj, R (T::*method)(Args...))
+  : _func{[obj, method](Args... args) -> R { return (obj->*method)(std::forward<Args>(args)...); }}
+  { }
+
+  R call(Args... args) const { return _func(std::forward<Args>(args)...); }
+  R operator () (Args... args) const { return call(std::forward<Args>(args)...); }
+  explicit operator bool() const { return static_cast<bool>(_func); }
+
+
+private:
+
+  class Undefined;
+  static size_t constexpr FUNCTOR_STORAGE_SIZE = sizeof(Undefined *) + sizeof(void (Undefined::*)());
+
+  std::function<R(Args...)> _func;
+
+};
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+template <typename R, typename... Args>
+Callback<R(Args...)> callback(R (*func)(Args...))
+{
+  return Callback<R(Args...)>(func);
+}
+
+template <typename T, typename U, typename R, typename... Args>
+Callback<R(Args...)> callback(U * obj, R (T::*method)(Args...))
+{
+  return Callback<R(Args...)>(obj, method);
+}
+
+} /* namespace mbed */
+
+#endif /* ARDUINO_THREADS_HOST_PLATFORM_CALLBACK_H_ */
@@ -0,0 +1,35 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_PLATFORM_MBED_CRITICAL_H_
+#define ARDUINO_THREADS_HOST_PLATFORM_MBED_CRITICAL_H_
+
+/**************************************************************************************
+ * FUNCTION DECLARATION
+ **************************************************************************************/
+
+/* On the targets a critical section disables interrupts, so the code
+ * within can not be preempted. On the host all critical sections are
+ * serialized via one global (recursive) lock instead, which provides
+ * the same mutual exclusion but does not prevent preemption.
+ */
+
+void core_util_critical_section_enter();
+void core_util_critical_section_exit();
+
+#endif /* ARDUINO_THREADS_HOST_PLATFORM_MBED_CRITICAL_H_ */
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_CONDITIONVARIABLE_H_
+#define ARDUINO_THREADS_HOST_RTOS_CONDITIONVARIABLE_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+
+#include "Kernel.h"
+#include "Mutex.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Condition variable bound to a rtos::Mutex. As with Mbed OS the mutex
+ * must be locked exactly once by the calling thread when waiting.
+ */
+class ConditionVariable
+{
+public:
+
+  ConditionVariable(Mutex & mutex);
+  ~ConditionVariable() { }
+
+  ConditionVariable(ConditionVariable const &) = delete;
+  ConditionVariable & operator = (ConditionVariable const &) = delete;
+
+
+  void wait();
+  /* Returns true if the timeout has expired. */
+  bool wait_for(uint32_t millisec);
+  bool wait_for(Kernel::Clock::duration_u32 rel_time);
+  bool wait_until(Kernel::Clock::time_point abs_time);
+
+  void notify_one();
+  void notify_all();
+
+
+private:
+
+  Mutex & _mutex;
+  std::atomic<uint32_t> _sequence;
+  /* Protected by _mutex. */
+  uint32_t _num_waiters;
+
+};
+
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_CONDITIONVARIABLE_H_ */
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_EVENTFLAGS_H_
+#define ARDUINO_THREADS_HOST_RTOS_EVENTFLAGS_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+
+#include "Kernel.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+class EventFlags
+{
+public:
+
+  EventFlags() : _flags{0} { }
+  EventFlags(const char *) : EventFlags() { }
+  ~EventFlags() { }
+
+  EventFlags(EventFlags const &) = delete;
+  EventFlags & operator = (EventFlags const &) = delete;
+
+
+  uint32_t set  (uint32_t flags);
+  uint32_t clear(uint32_t flags = 0x7fffffff);
+  uint32_t get  () const;
+
+  uint32_t wait_all(uint32_t flags = 0, uint32_t millisec = osWaitForever, bool clear = true);
+  uint32_t wait_any(uint32_t flags = 0, uint32_t millisec = osWaitForever, bool clear = true);
+  uint32_t wait_all_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear = true);
+  uint32_t wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear = true);
+
+
+private:
+
+  std::atomic<uint32_t> _flags;
+
+};
+
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_EVENTFLAGS_H_ */
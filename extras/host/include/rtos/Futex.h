@@ -0,0 +1,63 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_FUTEX_H_
+#define ARDUINO_THREADS_HOST_RTOS_FUTEX_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+namespace impl
+{
+
+/**************************************************************************************
+ * FUNCTION DECLARATION
+ **************************************************************************************/
+
+/* Block the calling thread as long as 'word' still contains 'expected',
+ * but no longer than 'timeout_ms' (osWaitForever to wait without limit).
+ * Spurious wake-ups are possible, callers must re-check their predicate.
+ * The wait is a thread cancellation point so that Thread::terminate()
+ * can stop a thread blocked on any of the host rtos primitives.
+ * Returns false if the timeout has expired.
+ */
+bool futex_wait(std::atomic<uint32_t> & word, uint32_t const expected, uint32_t const timeout_ms);
+void futex_wake_one(std::atomic<uint32_t> & word);
+void futex_wake_all(std::atomic<uint32_t> & word);
+
+/* Shared implementation of the CMSIS-RTOS2 flags semantics used
+ * by both EventFlags and the per-thread flags.
+ */
+uint32_t flags_set  (std::atomic<uint32_t> & flags, uint32_t const set);
+uint32_t flags_clear(std::atomic<uint32_t> & flags, uint32_t const clear);
+uint32_t flags_wait (std::atomic<uint32_t> & flags, uint32_t const wait, bool const wait_all, uint32_t const timeout_ms, bool const clear);
+
+} /* namespace impl */
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_FUTEX_H_ */
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_KERNEL_H_
+#define ARDUINO_THREADS_HOST_RTOS_KERNEL_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <chrono>
+#include <cstdint>
+
+#include "../cmsis_os2.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+namespace Kernel
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Monotonic millisecond clock, the host equivalent of the RTOS tick
+ * counter. Its epoch is the first time the clock is queried.
+ */
+struct Clock
+{
+  typedef std::chrono::milliseconds            duration;
+  typedef std::chrono::duration<uint32_t, std::milli> duration_u32;
+  typedef duration::rep                        rep;
+  typedef duration::period                     period;
+  typedef std::chrono::time_point<Clock>       time_point;
+  static bool constexpr is_steady = true;
+
+  static time_point now();
+};
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+static Clock::duration_u32 constexpr wait_for_u32_max    {osWaitForever - 1};
+static Clock::duration_u32 constexpr wait_for_u32_forever{osWaitForever};
+
+/**************************************************************************************
+ * FUNCTION DECLARATION
+ **************************************************************************************/
+
+uint64_t get_ms_count();
+
+} /* namespace Kernel */
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_KERNEL_H_ */
@@ -0,0 +1,171 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_MAIL_H_
+#define ARDUINO_THREADS_HOST_RTOS_MAIL_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Kernel.h"
+#include "Mutex.h"
+#include "ConditionVariable.h"
+
+#include "../platform/ScopedLock.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Fixed capacity mailbox consisting of a memory pool of 'queue_sz'
+ * blocks and a FIFO of pointers into that pool. Like the RTX memory
+ * pool the blocks are zeroed once at construction and handed out
+ * as raw memory, no constructors or destructors of T are invoked.
+ */
+template<typename T, uint32_t queue_sz>
+class Mail
+{
+public:
+
+  Mail()
+  : _pool_free_head{0}
+  , _queue_head{0}
+  , _queue_tail{0}
+  , _queue_count{0}
+  , _cond_mail_available(_mutex)
+  , _cond_block_available(_mutex)
+  {
+    memset(static_cast<void *>(_pool), 0, sizeof(_pool));
+    for (uint32_t i = 0; i < queue_sz; i++)
+      _pool_next[i] = i + 1;
+  }
+
+  Mail(Mail const &) = delete;
+  Mail & operator = (Mail const &) = delete;
+
+
+  bool empty() const { return (_queue_count == 0); }
+  bool full () const { return (_queue_count == queue_sz); }
+
+  T * try_alloc() { return try_alloc_for(Kernel::Clock::duration_u32::zero()); }
+  T * try_alloc_for(Kernel::Clock::duration_u32 rel_time)
+  {
+    mbed::ScopedLock<Mutex> lock(_mutex);
+    auto const deadline = Kernel::Clock::now() + rel_time;
+    while (_pool_free_head == queue_sz)
+    {
+      if (rel_time == Kernel::Clock::duration_u32::zero())
+        return nullptr;
+      if (rel_time == Kernel::wait_for_u32_forever)
+        _cond_block_available.wait();
+      else if (_cond_block_available.wait_until(deadline) && (_pool_free_head == queue_sz))
+        return nullptr;
+    }
+    uint32_t const idx = _pool_free_head;
+    _pool_free_head = _pool_next[idx];
+    return reinterpret_cast<T *>(&_pool[idx]);
+  }
+
+  T * try_calloc() { return try_calloc_for(Kernel::Clock::duration_u32::zero()); }
+  T * try_calloc_for(Kernel::Clock::duration_u32 rel_time)
+  {
+    T * ptr = try_alloc_for(rel_time);
+    if (ptr)
+      memset(static_cast<void *>(ptr), 0, sizeof(T));
+    return ptr;
+  }
+
+  osStatus put(T * mptr)
+  {
+    mbed::ScopedLock<Mutex> lock(_mutex);
+    if (full())
+      return osErrorResource;
+    _queue[_queue_head] = mptr;
+    _queue_head = (_queue_head + 1) % queue_sz;
+    _queue_count++;
+    _cond_mail_available.notify_one();
+    return osOK;
+  }
+
+  T * try_get() { return try_get_for(Kernel::Clock::duration_u32::zero()); }
+  T * try_get_for(Kernel::Clock::duration_u32 rel_time)
+  {
+    mbed::ScopedLock<Mutex> lock(_mutex);
+    auto const deadline = Kernel::Clock::now() + rel_time;
+    while (empty())
+    {
+      if (rel_time == Kernel::Clock::duration_u32::zero())
+        return nullptr;
+      if (rel_time == Kernel::wait_for_u32_forever)
+        _cond_mail_available.wait();
+      else if (_cond_mail_available.wait_until(deadline) && empty())
+        return nullptr;
+    }
+    T * mptr = _queue[_queue_tail];
+    _queue_tail = (_queue_tail + 1) % queue_sz;
+    _queue_count--;
+    return mptr;
+  }
+
+  osStatus free(T * mptr)
+  {
+    mbed::ScopedLock<Mutex> lock(_mutex);
+    uint32_t const idx = static_cast<uint32_t>(reinterpret_cast<Block *>(mptr) - _pool);
+    if (idx >= queue_sz)
+      return osErrorParameter;
+    _pool_next[idx] = _pool_free_head;
+    _pool_free_head = idx;
+    _cond_block_available.notify_one();
+    return osOK;
+  }
+
+
+private:
+
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Block;
+
+  Block _pool[queue_sz];
+  uint32_t _pool_next[queue_sz];
+  uint32_t _pool_free_head;
+
+  T * _queue[queue_sz];
+  uint32_t _queue_head, _queue_tail;
+  std::atomic<uint32_t> _queue_count;
+
+  Mutex _mutex;
+  ConditionVariable _cond_mail_available;
+  ConditionVariable _cond_block_available;
+
+};
+
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_MAIL_H_ */
@@ -0,0 +1,79 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_MUTEX_H_
+#define ARDUINO_THREADS_HOST_RTOS_MUTEX_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+
+#include "Kernel.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Recursive mutex with owner tracking, mirroring the semantics of the
+ * Mbed OS / RTX mutex. The lock word follows the classic three state
+ * futex protocol (0 = unlocked, 1 = locked, 2 = locked with waiters) so
+ * that the uncontended path never enters the kernel.
+ */
+class Mutex
+{
+public:
+
+  Mutex();
+  Mutex(const char * name);
+  ~Mutex() { }
+
+  Mutex(Mutex const &) = delete;
+  Mutex & operator = (Mutex const &) = delete;
+
+
+  void lock();
+  bool trylock();
+  bool trylock_for(Kernel::Clock::duration_u32 rel_time);
+  void unlock();
+
+  osThreadId_t get_owner();
+
+
+private:
+
+  std::atomic<uint32_t> _state;
+  std::atomic<osThreadId_t> _owner;
+  uint32_t _count;
+
+  bool acquire(uint32_t const timeout_ms);
+
+};
+
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_MUTEX_H_ */
@@ -0,0 +1,60 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_THISTHREAD_H_
+#define ARDUINO_THREADS_HOST_RTOS_THISTHREAD_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <cstdint>
+
+#include "Kernel.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+namespace ThisThread
+{
+
+/**************************************************************************************
+ * FUNCTION DECLARATION
+ **************************************************************************************/
+
+uint32_t flags_get();
+uint32_t flags_clear(uint32_t flags);
+uint32_t flags_wait_all(uint32_t flags, bool clear = true);
+uint32_t flags_wait_any(uint32_t flags, bool clear = true);
+uint32_t flags_wait_all_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear = true);
+uint32_t flags_wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear = true);
+
+void sleep_for(uint32_t millisec);
+void sleep_for(Kernel::Clock::duration_u32 rel_time);
+void yield();
+
+osThreadId_t get_id();
+const char * get_name();
+
+} /* namespace ThisThread */
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_THISTHREAD_H_ */
@@ -0,0 +1,117 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_HOST_RTOS_THREAD_H_
+#define ARDUINO_THREADS_HOST_RTOS_THREAD_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstdint>
+
+#include <pthread.h>
+
+#include "../cmsis_os2.h"
+#include "../platform/Callback.h"
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+#ifndef OS_STACK_SIZE
+# define OS_STACK_SIZE 4096
+#endif
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+namespace impl
+{
+
+/* Per-thread state which is addressed via osThreadId_t. Threads which
+ * have not been created via rtos::Thread (e.g. the main thread) obtain
+ * one lazily on their first call into the ThisThread API.
+ */
+struct ThreadControlBlock
+{
+  std::atomic<uint32_t> flags{0};
+  const char * name{nullptr};
+};
+
+ThreadControlBlock & this_thread_control_block();
+
+} /* namespace impl */
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Each rtos::Thread is backed by a POSIX thread. Priorities are recorded
+ * but not applied (realtime scheduling classes require privileges) and
+ * the requested stack size is raised to the host minimum if necessary.
+ */
+class Thread
+{
+public:
+
+  Thread(osPriority priority = osPriorityNormal,
+         uint32_t stack_size = OS_STACK_SIZE,
+         unsigned char * stack_mem = nullptr,
+         const char * name = nullptr);
+  ~Thread();
+
+  Thread(Thread const &) = delete;
+  Thread & operator = (Thread const &) = delete;
+
+
+  osStatus start(mbed::Callback<void()> task);
+  osStatus join();
+  osStatus terminate();
+
+  osStatus set_priority(osPriority priority);
+  osPriority get_priority() const;
+
+  uint32_t flags_set(uint32_t flags);
+
+  const char * get_name() const;
+  osThreadId_t get_id() const;
+
+
+private:
+
+  osPriority _priority;
+  uint32_t _stack_size;
+  mbed::Callback<void()> _task;
+  impl::ThreadControlBlock _tcb;
+  pthread_t _handle;
+  bool _is_started;
+  bool _is_joined;
+
+  static void * thunk(void * arg);
+
+};
+
+} /* namespace rtos */
+
+#endif /* ARDUINO_THREADS_HOST_RTOS_THREAD_H_ */
@@ -0,0 +1,75 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "Arduino.h"
+
+#include <atomic>
+
+#include "mbed.h"
+
+/**************************************************************************************
+ * INTERNAL VARIABLE
+ **************************************************************************************/
+
+static size_t constexpr NUM_PINS = 256;
+static std::atomic<uint8_t> pin_state[NUM_PINS];
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+void pinMode(pin_size_t, PinMode)
+{
+
+}
+
+void digitalWrite(pin_size_t pin, PinStatus val)
+{
+  pin_state[pin].store(static_cast<uint8_t>(val), std::memory_order_relaxed);
+}
+
+PinStatus digitalRead(pin_size_t pin)
+{
+  return static_cast<PinStatus>(pin_state[pin].load(std::memory_order_relaxed));
+}
+
+unsigned long millis()
+{
+  return static_cast<unsigned long>(rtos::Kernel::get_ms_count());
+}
+
+unsigned long micros()
+{
+  static auto const start = std::chrono::steady_clock::now();
+  return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void delay(unsigned long ms)
+{
+  rtos::ThisThread::sleep_for(static_cast<uint32_t>(ms));
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  unsigned long const start = micros();
+  while ((micros() - start) < us) { }
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "HostSerial.h"
+
+#include <cstdio>
+
+/**************************************************************************************
+ * GLOBAL VARIABLE DEFINITION
+ **************************************************************************************/
+
+arduino::HostSerial SerialUSB("SerialUSB");
+arduino::HostSerial Serial1("Serial1");
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+HostSerial::HostSerial(const char * name)
+: _name{name}
+, _is_open{false}
+, _echo{false}
+, _bytes_written{0}
+, _write_calls{0}
+{ }
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void HostSerial::begin(unsigned long baudrate)
+{
+  begin(baudrate, SERIAL_8N1);
+}
+
+void HostSerial::begin(unsigned long, uint16_t)
+{
+  _is_open = true;
+}
+
+void HostSerial::end()
+{
+  _is_open = false;
+}
+
+int HostSerial::available()
+{
+  std::lock_guard<std::mutex> lock(_rx_mutex);
+  return static_cast<int>(_rx_data.size());
+}
+
+int HostSerial::peek()
+{
+  std::lock_guard<std::mutex> lock(_rx_mutex);
+  return _rx_data.empty() ? -1 : _rx_data.front();
+}
+
+int HostSerial::read()
+{
+  std::lock_guard<std::mutex> lock(_rx_mutex);
+  if (_rx_data.empty())
+    return -1;
+  int const c = _rx_data.front();
+  _rx_data.pop_front();
+  return c;
+}
+
+void HostSerial::flush()
+{
+  if (_echo)
+    fflush(stdout);
+}
+
+size_t HostSerial::write(uint8_t const b)
+{
+  return write(&b, 1);
+}
+
+size_t HostSerial::write(const uint8_t * data, size_t len)
+{
+  _write_calls++;
+  _bytes_written += len;
+  if (_echo)
+    fwrite(data, 1, len, stdout);
+  return len;
+}
+
+void HostSerial::inject(const uint8_t * data, size_t len)
+{
+  std::lock_guard<std::mutex> lock(_rx_mutex);
+  _rx_data.insert(_rx_data.end(), data, data + len);
+}
+
+} /* namespace arduino */
@@ -0,0 +1,103 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "SPI.h"
+
+/**************************************************************************************
+ * GLOBAL VARIABLE DEFINITION
+ **************************************************************************************/
+
+arduino::HostSPI SPI;
+arduino::HostSPI SPI1;
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+HostSPI::HostSPI()
+: _transfer_calls{0}
+, _bytes_transferred{0}
+, _begin_transaction_calls{0}
+{ }
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+uint8_t HostSPI::transfer(uint8_t data)
+{
+  _transfer_calls++;
+  _bytes_transferred++;
+  return data;
+}
+
+uint16_t HostSPI::transfer16(uint16_t data)
+{
+  _transfer_calls++;
+  _bytes_transferred += 2;
+  return data;
+}
+
+void HostSPI::transfer(void *, size_t count)
+{
+  /* Loopback: the received data equals the transmitted data
+   * which is already stored within the buffer.
+   */
+  _transfer_calls++;
+  _bytes_transferred += count;
+}
+
+void HostSPI::beginTransaction(SPISettings)
+{
+  _begin_transaction_calls++;
+}
+
+void HostSPI::endTransaction(void)
+{
+
+}
+
+void HostSPI::begin()
+{
+
+}
+
+void HostSPI::end()
+{
+
+}
+
+void HostSPI::resetStatistics()
+{
+  _transfer_calls = 0;
+  _bytes_transferred = 0;
+  _begin_transaction_calls = 0;
+}
+
+} /* namespace arduino */
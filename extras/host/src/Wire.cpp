@@ -0,0 +1,134 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "Wire.h"
+
+#include <cstring>
+
+/**************************************************************************************
+ * GLOBAL VARIABLE DEFINITION
+ **************************************************************************************/
+
+arduino::HostI2C Wire;
+arduino::HostI2C Wire1;
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace arduino
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+HostI2C::HostI2C()
+: _tx_address{0}
+, _tx_len{0}
+, _rx_len{0}
+, _rx_idx{0}
+, _transactions{0}
+{
+  memset(_registers, 0, sizeof(_registers));
+  memset(_register_ptr, 0, sizeof(_register_ptr));
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void HostI2C::begin()
+{
+
+}
+
+void HostI2C::end()
+{
+
+}
+
+void HostI2C::beginTransmission(uint8_t address)
+{
+  _tx_address = address & 0x7F;
+  _tx_len = 0;
+}
+
+uint8_t HostI2C::endTransmission(bool)
+{
+  _transactions++;
+
+  if (_tx_len > 0)
+  {
+    uint8_t & reg = _register_ptr[_tx_address];
+    reg = _tx_buf[0];
+    for (size_t i = 1; i < _tx_len; i++)
+      _registers[_tx_address][reg++] = _tx_buf[i];
+  }
+
+  _tx_len = 0;
+  return 0;
+}
+
+size_t HostI2C::requestFrom(uint8_t address, size_t len, bool)
+{
+  _transactions++;
+
+  uint8_t const addr = address & 0x7F;
+  uint8_t & reg = _register_ptr[addr];
+
+  _rx_len = (len < BUFFER_SIZE) ? len : BUFFER_SIZE;
+  _rx_idx = 0;
+  for (size_t i = 0; i < _rx_len; i++)
+    _rx_buf[i] = _registers[addr][reg++];
+
+  return _rx_len;
+}
+
+size_t HostI2C::write(uint8_t data)
+{
+  if (_tx_len >= BUFFER_SIZE)
+    return 0;
+  _tx_buf[_tx_len++] = data;
+  return 1;
+}
+
+int HostI2C::available()
+{
+  return static_cast<int>(_rx_len - _rx_idx);
+}
+
+int HostI2C::read()
+{
+  if (_rx_idx >= _rx_len)
+    return -1;
+  return _rx_buf[_rx_idx++];
+}
+
+int HostI2C::peek()
+{
+  if (_rx_idx >= _rx_len)
+    return -1;
+  return _rx_buf[_rx_idx];
+}
+
+} /* namespace arduino */
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "rtos/ConditionVariable.h"
+
+#include <pthread.h>
+
+#include "rtos/Futex.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * INTERNAL CLASS DECLARATION
+ **************************************************************************************/
+
+/* Re-acquires the mutex when leaving a wait, also when the waiting
+ * thread is being cancelled, just as pthread_cond_wait() does. The
+ * mutex may be contended, cancellation is therefore disabled while
+ * re-acquiring as a destructor must not be left via forced unwinding.
+ */
+class Relock
+{
+public:
+  Relock(Mutex & mutex) : _mutex(mutex) { }
+  ~Relock()
+  {
+    int old_cancel_state;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &old_cancel_state);
+    _mutex.lock();
+    pthread_setcancelstate(old_cancel_state, nullptr);
+  }
+private:
+  Mutex & _mutex;
+};
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+ConditionVariable::ConditionVariable(Mutex & mutex)
+: _mutex(mutex)
+, _sequence{0}
+, _num_waiters{0}
+{ }
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void ConditionVariable::wait()
+{
+  wait_for(osWaitForever);
+}
+
+bool ConditionVariable::wait_for(uint32_t millisec)
+{
+  uint32_t const sequence = _sequence.load(std::memory_order_acquire);
+  bool is_timeout = false;
+  _num_waiters++;
+  {
+    _mutex.unlock();
+    Relock relock(_mutex);
+    is_timeout = !impl::futex_wait(_sequence, sequence, millisec);
+  }
+  _num_waiters--;
+  return is_timeout;
+}
+
+bool ConditionVariable::wait_for(Kernel::Clock::duration_u32 rel_time)
+{
+  return wait_for(rel_time.count());
+}
+
+bool ConditionVariable::wait_until(Kernel::Clock::time_point abs_time)
+{
+  auto const now = Kernel::Clock::now();
+  if (now >= abs_time)
+    return true;
+  return wait_for(static_cast<uint32_t>((abs_time - now).count()));
+}
+
+/* As with Mbed OS notifying requires the mutex to be held, the
+ * kernel only needs to be entered if a thread is actually waiting.
+ */
+
+void ConditionVariable::notify_one()
+{
+  if (_num_waiters == 0)
+    return;
+  _sequence.fetch_add(1, std::memory_order_release);
+  impl::futex_wake_one(_sequence);
+}
+
+void ConditionVariable::notify_all()
+{
+  if (_num_waiters == 0)
+    return;
+  _sequence.fetch_add(1, std::memory_order_release);
+  impl::futex_wake_all(_sequence);
+}
+
+} /* namespace rtos */
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "rtos/EventFlags.h"
+
+#include "rtos/Futex.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+uint32_t EventFlags::set(uint32_t flags)
+{
+  return impl::flags_set(_flags, flags);
+}
+
+uint32_t EventFlags::clear(uint32_t flags)
+{
+  return impl::flags_clear(_flags, flags);
+}
+
+uint32_t EventFlags::get() const
+{
+  return _flags.load(std::memory_order_acquire);
+}
+
+uint32_t EventFlags::wait_all(uint32_t flags, uint32_t millisec, bool clear)
+{
+  return impl::flags_wait(_flags, flags, true, millisec, clear);
+}
+
+uint32_t EventFlags::wait_any(uint32_t flags, uint32_t millisec, bool clear)
+{
+  return impl::flags_wait(_flags, flags, false, millisec, clear);
+}
+
+uint32_t EventFlags::wait_all_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear)
+{
+  return impl::flags_wait(_flags, flags, true, rel_time.count(), clear);
+}
+
+uint32_t EventFlags::wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear)
+{
+  return impl::flags_wait(_flags, flags, false, rel_time.count(), clear);
+}
+
+} /* namespace rtos */
@@ -0,0 +1,138 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "rtos/Futex.h"
+
+#include <cerrno>
+#include <ctime>
+
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "cmsis_os2.h"
+#include "rtos/Kernel.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+namespace impl
+{
+
+/**************************************************************************************
+ * INTERNAL FUNCTION DEFINITION
+ **************************************************************************************/
+
+static uint32_t remaining_ms(Kernel::Clock::time_point const deadline)
+{
+  auto const now = Kernel::Clock::now();
+  if (now >= deadline)
+    return 0;
+  return static_cast<uint32_t>((deadline - now).count());
+}
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+bool futex_wait(std::atomic<uint32_t> & word, uint32_t const expected, uint32_t const timeout_ms)
+{
+  struct timespec timeout;
+  struct timespec * timeout_ptr = nullptr;
+  if (timeout_ms != osWaitForever)
+  {
+    timeout.tv_sec  = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000L;
+    timeout_ptr = &timeout;
+  }
+
+  /* A raw futex system call is not a POSIX cancellation point, therefore
+   * asynchronous cancellation is enabled for the duration of the call,
+   * which is the same approach glibc uses for its own blocking calls.
+   */
+  int old_cancel_type;
+  pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, &old_cancel_type);
+  long const rc = syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT_PRIVATE, expected, timeout_ptr, nullptr, 0);
+  int const err = errno;
+  pthread_setcanceltype(old_cancel_type, nullptr);
+
+  return !((rc == -1) && (err == ETIMEDOUT));
+}
+
+void futex_wake_one(std::atomic<uint32_t> & word)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+void futex_wake_all(std::atomic<uint32_t> & word)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+uint32_t flags_set(std::atomic<uint32_t> & flags, uint32_t const set)
+{
+  uint32_t const new_flags = flags.fetch_or(set, std::memory_order_acq_rel) | set;
+  futex_wake_all(flags);
+  return new_flags;
+}
+
+uint32_t flags_clear(std::atomic<uint32_t> & flags, uint32_t const clear)
+{
+  return flags.fetch_and(~clear, std::memory_order_acq_rel);
+}
+
+uint32_t flags_wait(std::atomic<uint32_t> & flags, uint32_t const wait, bool const wait_all, uint32_t const timeout_ms, bool const clear)
+{
+  auto const deadline = Kernel::Clock::now() + Kernel::Clock::duration(timeout_ms);
+
+  for (;;)
+  {
+    uint32_t current = flags.load(std::memory_order_acquire);
+    bool const is_satisfied = wait_all ? ((current & wait) == wait) : ((current & wait) != 0);
+
+    if (is_satisfied)
+    {
+      if (!clear)
+        return current;
+      if (flags.compare_exchange_weak(current, current & ~wait, std::memory_order_acq_rel))
+        return current;
+      continue;
+    }
+
+    uint32_t timeout = osWaitForever;
+    if (timeout_ms != osWaitForever)
+    {
+      timeout = remaining_ms(deadline);
+      if (timeout == 0)
+        return osFlagsErrorTimeout;
+    }
+
+    futex_wait(flags, current, timeout);
+  }
+}
+
+} /* namespace impl */
+} /* namespace rtos */
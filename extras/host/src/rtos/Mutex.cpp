@@ -0,0 +1,132 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "rtos/Mutex.h"
+
+#include "rtos/Futex.h"
+#include "rtos/ThisThread.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+Mutex::Mutex()
+: _state{0}
+, _owner{nullptr}
+, _count{0}
+{ }
+
+Mutex::Mutex(const char *)
+: Mutex()
+{ }
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void Mutex::lock()
+{
+  acquire(osWaitForever);
+}
+
+bool Mutex::trylock()
+{
+  return acquire(0);
+}
+
+bool Mutex::trylock_for(Kernel::Clock::duration_u32 rel_time)
+{
+  return acquire(rel_time.count());
+}
+
+void Mutex::unlock()
+{
+  if (--_count > 0)
+    return;
+
+  _owner.store(nullptr, std::memory_order_relaxed);
+  if (_state.fetch_sub(1, std::memory_order_release) != 1)
+  {
+    _state.store(0, std::memory_order_release);
+    impl::futex_wake_one(_state);
+  }
+}
+
+osThreadId_t Mutex::get_owner()
+{
+  return _owner.load(std::memory_order_relaxed);
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool Mutex::acquire(uint32_t const timeout_ms)
+{
+  osThreadId_t const self = ThisThread::get_id();
+
+  /* Recursive locking by the current owner. */
+  if (_owner.load(std::memory_order_relaxed) == self)
+  {
+    _count++;
+    return true;
+  }
+
+  uint32_t state = 0;
+  if (!_state.compare_exchange_strong(state, 1, std::memory_order_acquire))
+  {
+    if (timeout_ms == 0)
+      return false;
+
+    auto const deadline = Kernel::Clock::now() + Kernel::Clock::duration(timeout_ms);
+
+    if (state != 2)
+      state = _state.exchange(2, std::memory_order_acquire);
+
+    while (state != 0)
+    {
+      uint32_t timeout = osWaitForever;
+      if (timeout_ms != osWaitForever)
+      {
+        auto const now = Kernel::Clock::now();
+        if (now >= deadline)
+          return false;
+        timeout = static_cast<uint32_t>((deadline - now).count());
+      }
+      impl::futex_wait(_state, 2, timeout);
+      state = _state.exchange(2, std::memory_order_acquire);
+    }
+  }
+
+  _owner.store(self, std::memory_order_relaxed);
+  _count = 1;
+  return true;
+}
+
+} /* namespace rtos */
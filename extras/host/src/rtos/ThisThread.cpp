@@ -0,0 +1,107 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "rtos/ThisThread.h"
+
+#include <cerrno>
+#include <ctime>
+
+#include <sched.h>
+
+#include "rtos/Futex.h"
+#include "rtos/Thread.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+namespace ThisThread
+{
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+uint32_t flags_get()
+{
+  return impl::this_thread_control_block().flags.load(std::memory_order_acquire);
+}
+
+uint32_t flags_clear(uint32_t flags)
+{
+  return impl::flags_clear(impl::this_thread_control_block().flags, flags);
+}
+
+uint32_t flags_wait_all(uint32_t flags, bool clear)
+{
+  return impl::flags_wait(impl::this_thread_control_block().flags, flags, true, osWaitForever, clear);
+}
+
+uint32_t flags_wait_any(uint32_t flags, bool clear)
+{
+  return impl::flags_wait(impl::this_thread_control_block().flags, flags, false, osWaitForever, clear);
+}
+
+uint32_t flags_wait_all_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear)
+{
+  return impl::flags_wait(impl::this_thread_control_block().flags, flags, true, rel_time.count(), clear);
+}
+
+uint32_t flags_wait_any_for(uint32_t flags, Kernel::Clock::duration_u32 rel_time, bool clear)
+{
+  return impl::flags_wait(impl::this_thread_control_block().flags, flags, false, rel_time.count(), clear);
+}
+
+void sleep_for(uint32_t millisec)
+{
+  struct timespec req, rem;
+  req.tv_sec  = millisec / 1000;
+  req.tv_nsec = (millisec % 1000) * 1000000L;
+  /* nanosleep is a cancellation point. */
+  while ((nanosleep(&req, &rem) == -1) && (errno == EINTR))
+    req = rem;
+}
+
+void sleep_for(Kernel::Clock::duration_u32 rel_time)
+{
+  sleep_for(rel_time.count());
+}
+
+void yield()
+{
+  sched_yield();
+}
+
+osThreadId_t get_id()
+{
+  return &impl::this_thread_control_block();
+}
+
+const char * get_name()
+{
+  return impl::this_thread_control_block().name;
+}
+
+} /* namespace ThisThread */
+} /* namespace rtos */
@@ -0,0 +1,196 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "rtos/Thread.h"
+
+#include <cstring>
+#include <algorithm>
+
+#include "rtos/Futex.h"
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+/* Stack sizes chosen for the Cortex-M targets are far too small for
+ * the host ABI and C library, hence they are raised to this minimum.
+ */
+static size_t constexpr HOST_MIN_STACK_SIZE = 256 * 1024;
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace rtos
+{
+
+/**************************************************************************************
+ * INTERNAL VARIABLE
+ **************************************************************************************/
+
+namespace impl
+{
+
+static thread_local ThreadControlBlock * this_thread_tcb = nullptr;
+
+ThreadControlBlock & this_thread_control_block()
+{
+  if (!this_thread_tcb)
+  {
+    static thread_local ThreadControlBlock foreign_thread_tcb;
+    this_thread_tcb = &foreign_thread_tcb;
+  }
+  return *this_thread_tcb;
+}
+
+} /* namespace impl */
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+Thread::Thread(osPriority priority, uint32_t stack_size, unsigned char *, const char * name)
+: _priority{priority}
+, _stack_size{stack_size}
+, _task{}
+, _tcb{}
+, _handle{}
+, _is_started{false}
+, _is_joined{false}
+{
+  _tcb.name = name;
+}
+
+Thread::~Thread()
+{
+  terminate();
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+osStatus Thread::start(mbed::Callback<void()> task)
+{
+  if (_is_started)
+    return osErrorParameter;
+
+  _task = task;
+
+  pthread_attr_t attr;
+  pthread_attr_init(&attr);
+  pthread_attr_setstacksize(&attr, std::max<size_t>(_stack_size, HOST_MIN_STACK_SIZE));
+  int const rc = pthread_create(&_handle, &attr, Thread::thunk, this);
+  pthread_attr_destroy(&attr);
+
+  if (rc != 0)
+    return osErrorNoMemory;
+
+  _is_started = true;
+  return osOK;
+}
+
+osStatus Thread::join()
+{
+  if (!_is_started || _is_joined)
+    return osOK;
+  if (pthread_equal(_handle, pthread_self()))
+    return osError;
+
+  pthread_join(_handle, nullptr);
+  _is_joined = true;
+  return osOK;
+}
+
+osStatus Thread::terminate()
+{
+  if (!_is_started || _is_joined)
+    return osOK;
+  if (pthread_equal(_handle, pthread_self()))
+    pthread_exit(nullptr);
+
+  pthread_cancel(_handle);
+  pthread_join(_handle, nullptr);
+  _is_joined = true;
+  return osOK;
+}
+
+osStatus Thread::set_priority(osPriority priority)
+{
+  _priority = priority;
+  return osOK;
+}
+
+osPriority Thread::get_priority() const
+{
+  return _priority;
+}
+
+uint32_t Thread::flags_set(uint32_t flags)
+{
+  return impl::flags_set(_tcb.flags, flags);
+}
+
+const char * Thread::get_name() const
+{
+  return _tcb.name;
+}
+
+osThreadId_t Thread::get_id() const
+{
+  return const_cast<impl::ThreadControlBlock *>(&_tcb);
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void * Thread::thunk(void * arg)
+{
+  Thread * this_ptr = reinterpret_cast<Thread *>(arg);
+
+  impl::this_thread_tcb = &this_ptr->_tcb;
+
+  if (this_ptr->_tcb.name)
+  {
+    /* Linux limits thread names to 15 characters. */
+    char name[16] = {0};
+    strncpy(name, this_ptr->_tcb.name, sizeof(name) - 1);
+    pthread_setname_np(pthread_self(), name);
+  }
+
+  this_ptr->_task();
+  return nullptr;
+}
+
+} /* namespace rtos */
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags)
+{
+  if (!thread_id)
+    return osFlagsErrorParameter;
+  return rtos::impl::flags_set(reinterpret_cast<rtos::impl::ThreadControlBlock *>(thread_id)->flags, flags);
+}
@@ -28,7 +28,10 @@
 
 #include "threading/Sink.hpp"
 #include "threading/Source.hpp"
+#include "threading/LoanSource.hpp"
 #include "threading/Shared.hpp"
+#include "threading/SharedLatest.hpp"
+#include "threading/SharedBroadcast.hpp"
 
 #include "io/BusDevice.h"
 #include "io/util/util.h"
@@ -40,16 +43,29 @@
  * DEFINE
  **************************************************************************************/
 
-#define SOURCE(name, type) \
+#define SOURCE_2_ARG(name, type) \
 Source<type> name;
 
-/* We need to call the SinkBlocking<T>(size_t const size)
- * non-default constructor using size as parameter.
+#define SOURCE_3_ARG(name, type, max_sinks) \
+Source<type, max_sinks> name;
 
- * This is achieved via
- *   SinkBlocking<type> name{size};
+#define GET_SOURCE_MACRO(_1,_2,_3,NAME,...) NAME
+#define SOURCE(...) GET_SOURCE_MACRO(__VA_ARGS__, SOURCE_3_ARG, SOURCE_2_ARG)(__VA_ARGS__)
+
+/* A SOURCE_LOAN publishes values of 'type' stored within a pool of
+ * 'pool_size' slots, connected sinks are declared with 'Slot<type>'.
+ */
+#define SOURCE_LOAN(name, type, pool_size) \
+LoanSource<type, pool_size> name;
+
+/* The size of a SINK is passed as a template parameter,
+ * i.e. SinkBlocking<type, size>, so that the sink is a
+ * completely static object which requires no heap memory.
+
+ * The sink is declared via
+ *   SinkBlocking<type, size> name{};
  * instead of
- *   SinkBlocking<type> name(size);
+ *   SinkBlocking<type, size> name();
  * otherwise the compiler will read it as a declaration
  * of a method called "name" and we get a syntax error.
  *
@@ -59,17 +75,37 @@ Source<type> name;
  */
 
 #define SINK_2_ARG(name, type) \
-SinkBlocking<type> name{1}
+SinkBlocking<type, 1> name{}
 
 #define SINK_3_ARG(name, type, size) \
-SinkBlocking<type> name{size}
+SinkBlocking<type, size> name{}
+
+/* The overflow policy determines what happens when a value
+ * is injected into a full sink, e.g.
+ *   SINK(name, type, size, SinkOverflowPolicy::DropOldest);
+ */
+#define SINK_4_ARG(name, type, size, policy) \
+SinkBlocking<type, size, policy> name{}
 
 /* Black C macro magic enabling "macro overloading"
  * with same name macro, but multiple arguments.
  * https://stackoverflow.com/questions/11761703/overloading-macro-on-number-of-arguments
  */
-#define GET_SINK_MACRO(_1,_2,_3,NAME,...) NAME
-#define SINK(...) GET_SINK_MACRO(__VA_ARGS__, SINK_3_ARG, SINK_2_ARG)(__VA_ARGS__)
+#define GET_SINK_MACRO(_1,_2,_3,_4,NAME,...) NAME
+#define SINK(...) GET_SINK_MACRO(__VA_ARGS__, SINK_4_ARG, SINK_3_ARG, SINK_2_ARG)(__VA_ARGS__)
+
+/* A SINK_SPSC must be connected to exactly one SOURCE and must
+ * be read from exactly one thread. Its size needs to be a power
+ * of two which is known at compile time.
+ */
+#define SINK_SPSC_2_ARG(name, type) \
+SinkSpsc<type, 1> name{}
+
+#define SINK_SPSC_3_ARG(name, type, size) \
+SinkSpsc<type, size> name{}
+
+#define GET_SINK_SPSC_MACRO(_1,_2,_3,NAME,...) NAME
+#define SINK_SPSC(...) GET_SINK_SPSC_MACRO(__VA_ARGS__, SINK_SPSC_3_ARG, SINK_SPSC_2_ARG)(__VA_ARGS__)
 
 #define SINK_NON_BLOCKING(name, type) \
 SinkNonBlocking<type> name{}
@@ -86,6 +122,27 @@ source_thread##Private::source_name.connectTo(sink_thread##Private::sink_name)
 #define GET_SHARED_MACRO(_1,_2,_3,NAME,...) NAME
 #define SHARED(...) GET_SHARED_MACRO(__VA_ARGS__, SHARED_3_ARG, SHARED_2_ARG)(__VA_ARGS__)
 
+/* A SHARED_LATEST variable only holds the most recently pushed
+ * value, pushing never blocks and pop() never waits.
+ */
+#define SHARED_LATEST(name, type) \
+  SharedLatest<type> name;
+
+/* Every value pushed to a SHARED_BROADCAST variable is received by
+ * every SHARED_READER declared for it, each within its own thread.
+ */
+#define SHARED_BROADCAST_2_ARG(name, type) \
+  SharedBroadcast<type> name;
+
+#define SHARED_BROADCAST_3_ARG(name, type, size) \
+  SharedBroadcast<type, size> name;
+
+#define GET_SHARED_BROADCAST_MACRO(_1,_2,_3,NAME,...) NAME
+#define SHARED_BROADCAST(...) GET_SHARED_BROADCAST_MACRO(__VA_ARGS__, SHARED_BROADCAST_3_ARG, SHARED_BROADCAST_2_ARG)(__VA_ARGS__)
+
+#define SHARED_READER(name, shared_name) \
+  decltype(shared_name)::Reader name{shared_name};
+
 
 #define ARDUINO_THREADS_CONCAT_(x,y) x##y
 #define ARDUINO_THREADS_CONCAT(x,y) ARDUINO_THREADS_CONCAT_(x,y)
@@ -105,9 +105,14 @@ BusDevice::BusDevice(arduino::HardwareI2C & wire, byte const slave_addr, bool co
   *this = BusDeviceBase::create(wire, slave_addr, restart, stop);
 }
 
-IoResponse BusDevice::transfer(IoRequest & req)
+IoResponse BusDevice::transfer(IoRequest & req, IoCompletionCallback on_complete)
 {
-  return _dev->transfer(req);
+  return _dev->transfer(req, on_complete);
+}
+
+void BusDevice::transferAndWait(IoRequest & req, IoResult & result)
+{
+  _dev->transferAndWait(req, result);
 }
 
 SpiBusDevice & BusDevice::spi()
@@ -23,6 +23,8 @@
  * INCLUDE
  **************************************************************************************/
 
+#include <SharedPtr.h>
+
 #include "IoTransaction.h"
 
 #include "spi/SpiBusDeviceConfig.h"
@@ -51,7 +53,14 @@ public:
 
   virtual ~BusDeviceBase() { }
 
-  virtual IoResponse transfer(IoRequest & req) = 0;
+  /* 'on_complete' (optional) is invoked by the dispatcher thread once the
+   * request has been processed, alternatively wait on the response.
+   */
+  virtual IoResponse transfer(IoRequest & req, IoCompletionCallback on_complete = nullptr) = 0;
+  /* Blocks until the request has been processed, the outcome is stored
+   * in 'result' which is owned by the caller.
+   */
+  virtual void transferAndWait(IoRequest & req, IoResult & result) = 0;
 
 
   static BusDevice create(arduino::HardwareSPI & spi, int const cs_pin, SPISettings const & spi_settings, byte const fill_symbol = 0xFF);
@@ -78,7 +87,8 @@ public:
   BusDevice(arduino::HardwareI2C & wire, byte const slave_addr, bool const restart);
   BusDevice(arduino::HardwareI2C & wire, byte const slave_addr, bool const restart, bool const stop);
 
-  IoResponse transfer(IoRequest & req);
+  IoResponse transfer(IoRequest & req, IoCompletionCallback on_complete = nullptr);
+  void transferAndWait(IoRequest & req, IoResult & result);
 
 
   SpiBusDevice  & spi();
@@ -27,12 +27,68 @@
 
 #include <mbed.h>
 
-#include <SharedPtr.h>
+#include <atomic>
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+enum class IoPriority : size_t
+{
+  Low = 0,
+  Normal,
+  High,
+};
+
+static size_t constexpr IO_PRIORITY_NUM_LEVELS = 3;
+
+enum class IoStatus
+{
+  Ok = 0,
+  QueueFull,       /* The request could not be queued, it has not been executed. */
+  DeadlineMissed,  /* The request could not be started by its deadline, it has not been executed. */
+  Nak,             /* The device did not acknowledge its address or data (I2C). */
+  Timeout,         /* The device did not respond within its timeout. */
+  ArbitrationLost, /* Another controller took over the bus (I2C). */
+  Error,           /* Any other error reported by the bus driver. */
+};
 
 /**************************************************************************************
  * CLASS DECLARATION
  **************************************************************************************/
 
+/**************************************************************************************
+ * IoSegment
+ **************************************************************************************/
+
+/* A single segment of a scatter-gather IoRequest. A segment either
+ * transmits (tx_buf only), receives (rx_buf only) or does both at
+ * the same time (full-duplex, SPI only). tx_buf and rx_buf may refer
+ * to the same memory in which case the data is transferred in place.
+ */
+class IoSegment
+{
+public:
+
+  IoSegment()
+  : IoSegment{nullptr, nullptr, 0}
+  { }
+
+  IoSegment(byte const * tx_buf_, byte * rx_buf_, size_t const len_)
+  : tx_buf{tx_buf_}
+  , rx_buf{rx_buf_}
+  , len{len_}
+  { }
+
+  static inline IoSegment tx    (byte const * buf, size_t const len) { return IoSegment{buf, nullptr, len}; }
+  static inline IoSegment rx    (byte * buf, size_t const len)       { return IoSegment{nullptr, buf, len}; }
+  static inline IoSegment duplex(byte const * tx_buf, byte * rx_buf, size_t const len) { return IoSegment{tx_buf, rx_buf, len}; }
+
+  byte const * tx_buf;
+  byte * rx_buf;
+  size_t len;
+};
+
 /**************************************************************************************
  * IoRequest
  **************************************************************************************/
@@ -41,31 +97,97 @@ class IoRequest
 {
 public:
 
-  IoRequest(byte * write_buf_, size_t const bytes_to_write_, byte * read_buf_, size_t const bytes_to_read_)
+  IoRequest(byte const * write_buf_, size_t const bytes_to_write_, byte * read_buf_, size_t const bytes_to_read_)
   : write_buf{write_buf_}
   , bytes_to_write{bytes_to_write_}
   , read_buf{read_buf_}
   , bytes_to_read{bytes_to_read_}
   { }
 
-  IoRequest(byte & write_buf_, byte & read_buf_)
+  IoRequest(byte const & write_buf_, byte & read_buf_)
   : IoRequest{&write_buf_, 1, &read_buf_, 1}
   { }
 
-  byte * write_buf{nullptr};
+  /* Full-duplex transfer (SPI only): the data received while write_buf
+   * is transmitted is stored in write_rx_buf (which may be write_buf
+   * itself in order to transfer in place).
+   */
+  IoRequest(byte const * write_buf_, byte * write_rx_buf_, size_t const bytes_to_write_)
+  : IoRequest{write_buf_, bytes_to_write_, nullptr, 0}
+  {
+    write_rx_buf = write_rx_buf_;
+  }
+
+  /* All segments are executed back-to-back within a single bus
+   * transaction, i.e. under one chip select assertion (SPI) or
+   * separated by repeated starts (I2C, if enabled for the device).
+   * The segment list must remain valid until the request is done.
+   */
+  IoRequest(IoSegment const * segments_, size_t const num_segments_)
+  : IoRequest{nullptr, 0, nullptr, 0}
+  {
+    segments = segments_;
+    num_segments = num_segments_;
+  }
+
+  byte const * write_buf{nullptr};
   size_t const bytes_to_write{0};
+  /* Receives the data clocked in while write_buf is transmitted (SPI
+   * only), the data is discarded if nullptr. write_buf is never modified
+   * unless write_rx_buf refers to it.
+   */
+  byte * write_rx_buf{nullptr};
   byte * read_buf{nullptr};
   size_t const bytes_to_read{0};
 
+  /* If set the request is executed as a list of segments,
+   * write_buf and read_buf are ignored.
+   */
+  IoSegment const * segments{nullptr};
+  size_t num_segments{0};
+
+  /* Requests of higher priority are processed first, requests
+   * of equal priority in the order they have been submitted.
+   */
+  IoPriority priority{IoPriority::Normal};
+  /* A request not started by its deadline is discarded without
+   * accessing the bus, see IoResponse::deadline_missed.
+   */
+  rtos::Kernel::Clock::time_point deadline{rtos::Kernel::Clock::time_point::max()};
+  /* Maximum time to wait for space within the request queue of the
+   * dispatcher, by default a request is rejected immediately with
+   * IoStatus::QueueFull if the queue is full.
+   */
+  rtos::Kernel::Clock::duration_u32 queue_timeout{0};
+
 };
 
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+/* Thread flag used to resume a thread waiting for the completion of
+ * an IO request. Do not use this flag for events sent via
+ * Arduino_Threads::sendEvent().
+ */
+static uint32_t constexpr IO_RESPONSE_THREAD_FLAG = (1UL << 29);
+
 /**************************************************************************************
  * IoResponse
  **************************************************************************************/
 
+class IoResponse;
+
+/* Invoked within the context of the dispatcher thread as soon
+ * as the request has been processed, must not block.
+ */
+typedef mbed::Callback<void(IoResponse const &)> IoCompletionCallback;
+
 namespace impl
 {
 
+class IoResponsePoolBase;
+
 class IoResponse
 {
 public:
@@ -73,41 +195,332 @@ public:
   IoResponse()
   : bytes_written{0}
   , bytes_read{0}
-  , _cond{_mutex}
+  , queueing_delay{0}
+  , deadline_missed{false}
+  , status{IoStatus::Ok}
   , _is_done{false}
+  , _waiting_thread{nullptr}
+  , _has_extra_waiters{false}
+  , _is_single_waiter{false}
+  , _on_complete{nullptr}
+  , _ref_cnt{0}
+  , _pool{nullptr}
   { }
 
+  IoResponse(IoResponse const &) = delete;
+  IoResponse & operator = (IoResponse const &) = delete;
+
   size_t bytes_written{0};
   size_t bytes_read{0};
+  /* Time between submitting the request and the dispatcher starting it. */
+  rtos::Kernel::Clock::duration queueing_delay{0};
+  bool deadline_missed{false};
+  /* If not IoStatus::Ok the request has been aborted, bytes_written
+   * and bytes_read report how far it progressed.
+   */
+  IoStatus status{IoStatus::Ok};
+
+  void done();
+  /* Clears the response and registers the calling thread as the one to
+   * wait() for it before the request is submitted. Required for responses
+   * which are destroyed right after wait() returns, e.g. on the stack.
+   * No other thread may wait() for such a response.
+   */
+  void prepareWait();
+  /* Any number of threads may wait for a response. The first one is
+   * resumed via a thread flag, any further ones via a condition variable
+   * shared among all responses.
+   */
+  void wait();
+  inline bool isDone() const { return _is_done.load(std::memory_order_acquire); }
+
+
+private:
+
+  std::atomic<bool> _is_done;
+  std::atomic<osThreadId_t> _waiting_thread;
+  std::atomic<bool> _has_extra_waiters;
+  bool _is_single_waiter; /* Set by prepareWait(). */
+  IoCompletionCallback _on_complete;
+  volatile uint32_t _ref_cnt;
+  IoResponsePoolBase * _pool;
+
+  static rtos::Mutex _extra_waiters_mutex;
+  static rtos::ConditionVariable _extra_waiters_cond;
+
+  void reset(IoCompletionCallback const & on_complete);
+
+  friend class ::IoResponse;
+  friend class IoResponsePoolBase;
+};
 
-  void done()
+class IoResponsePoolBase
+{
+public:
+
+  virtual ~IoResponsePoolBase() { }
+
+  virtual void free(IoResponse * rsp) = 0;
+
+protected:
+
+  static inline void attach(IoResponse & rsp, IoResponsePoolBase * pool) { rsp._pool = pool; }
+  static inline void reset (IoResponse & rsp, IoCompletionCallback const & on_complete) { rsp.reset(on_complete); }
+};
+
+} /* namespace impl */
+
+/* Reference counted handle to an impl::IoResponse. The response
+ * is returned to the pool of its dispatcher as soon as the last
+ * handle referring to it is destroyed. Any number of threads may
+ * wait() for the response via their own handle.
+ */
+class IoResponse
+{
+public:
+
+  IoResponse() : _rsp{nullptr}, _is_counted{true} { }
+  IoResponse(std::nullptr_t) : _rsp{nullptr}, _is_counted{true} { }
+  explicit IoResponse(impl::IoResponse * rsp) : _rsp{rsp}, _is_counted{true} { acquire(); }
+  IoResponse(IoResponse const & other) : _rsp{other._rsp}, _is_counted{other._is_counted} { acquire(); }
+  IoResponse(IoResponse && other) : _rsp{other._rsp}, _is_counted{other._is_counted} { other._rsp = nullptr; }
+  ~IoResponse() { release(); }
+
+  /* Handle to a response whose lifetime is guaranteed by its owner
+   * (e.g. a response on the stack of a thread waiting for it). Such
+   * a handle never accesses the response on its own, it may therefore
+   * be destroyed after the response itself.
+   */
+  static IoResponse unmanaged(impl::IoResponse * rsp)
   {
-    _mutex.lock();
-    _is_done = true;
-    _cond.notify_all();
-    _mutex.unlock();
+    IoResponse handle;
+    handle._rsp = rsp;
+    handle._is_counted = false;
+    return handle;
   }
 
-  void wait()
+  IoResponse & operator = (IoResponse const & other)
   {
-    _mutex.lock();
-    while (!_is_done) {
-      _cond.wait();
+    if (_rsp != other._rsp)
+    {
+      release();
+      _rsp = other._rsp;
+      _is_counted = other._is_counted;
+      acquire();
     }
-    _mutex.unlock();
+    return *this;
   }
 
+  IoResponse & operator = (IoResponse && other)
+  {
+    if (this != &other)
+    {
+      release();
+      _rsp = other._rsp;
+      _is_counted = other._is_counted;
+      other._rsp = nullptr;
+    }
+    return *this;
+  }
+
+  inline impl::IoResponse * operator -> () const { return _rsp; }
+  inline impl::IoResponse & operator *  () const { return *_rsp; }
+  inline impl::IoResponse * get() const { return _rsp; }
+  inline explicit operator bool() const { return (_rsp != nullptr); }
+
+
 private:
 
-  rtos::Mutex _mutex;
-  rtos::ConditionVariable _cond;
-  bool _is_done{false};
+  impl::IoResponse * _rsp;
+  bool _is_counted;
+
+  void acquire()
+  {
+    if (_rsp && _is_counted)
+      core_util_atomic_incr_u32(&_rsp->_ref_cnt, 1);
+  }
 
+  void release()
+  {
+    if (_rsp && _is_counted && (core_util_atomic_decr_u32(&_rsp->_ref_cnt, 1) == 0) && _rsp->_pool)
+      _rsp->_pool->free(_rsp);
+    _rsp = nullptr;
+  }
 };
 
-} /* namespace impl */
+inline bool operator == (IoResponse const & rsp, std::nullptr_t) { return !rsp; }
+inline bool operator != (IoResponse const & rsp, std::nullptr_t) { return static_cast<bool>(rsp); }
+
+/* Result of a synchronous transfer, provided by the caller (e.g. on its
+ * stack) instead of being taken from the pool of the dispatcher.
+ */
+typedef impl::IoResponse IoResult;
+
+namespace impl
+{
 
-typedef mbed::SharedPtr<impl::IoResponse> IoResponse;
+/* Fixed pool of SIZE responses, alloc_until() returns nullptr if all
+ * responses are still referenced by a handle until the deadline.
+ */
+template <size_t SIZE>
+class IoResponsePool : public IoResponsePoolBase
+{
+public:
+
+  IoResponsePool()
+  : _free_head{nullptr}
+  , _num_allocations{0}
+  , _cond_response_available(_mutex)
+  {
+    for (size_t i = 0; i < SIZE; i++)
+    {
+      attach(_rsp[i], this);
+      _next_free[i] = _free_head;
+      _free_head = &_rsp[i];
+    }
+  }
+
+  ::IoResponse alloc_until(IoCompletionCallback const & on_complete, rtos::Kernel::Clock::time_point const deadline)
+  {
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    while (!_free_head)
+    {
+      if (deadline <= rtos::Kernel::Clock::now())
+        return nullptr;
+      if (deadline == rtos::Kernel::Clock::time_point::max())
+        _cond_response_available.wait();
+      else
+        _cond_response_available.wait_until(deadline);
+    }
+    IoResponse * rsp = _free_head;
+    _free_head = _next_free[rsp - _rsp];
+    _num_allocations++;
+    reset(*rsp, on_complete);
+    return ::IoResponse(rsp);
+  }
+
+  virtual void free(IoResponse * rsp) override
+  {
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    _next_free[rsp - _rsp] = _free_head;
+    _free_head = rsp;
+    _cond_response_available.notify_one();
+  }
+
+  /* Number of responses taken from the pool since its creation. */
+  size_t allocations()
+  {
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+    return _num_allocations;
+  }
+
+
+private:
+
+  IoResponse _rsp[SIZE];
+  IoResponse * _next_free[SIZE];
+  IoResponse * _free_head;
+  size_t _num_allocations;
+  rtos::Mutex _mutex;
+  rtos::ConditionVariable _cond_response_available;
+};
+
+/**************************************************************************************
+ * IoResponse PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+inline void IoResponse::done()
+{
+  if (_on_complete)
+    _on_complete(::IoResponse(this));
+
+  /* Publish the completion before checking for a waiting thread,
+   * wait() does the opposite, so one of both always notices the
+   * other (the same protocol as used by SinkSpsc). A thread which
+   * registered itself beforehand (see prepareWait()) is looked up
+   * before publishing, the response is not accessed anymore once
+   * the waiting thread may return. All other responses are kept
+   * alive by the handles of their waiting threads.
+   */
+  osThreadId_t waiting_thread = _waiting_thread.load(std::memory_order_seq_cst);
+  bool const is_single_waiter = _is_single_waiter;
+  _is_done.store(true, std::memory_order_seq_cst);
+  if (!is_single_waiter)
+  {
+    if (!waiting_thread)
+      waiting_thread = _waiting_thread.load(std::memory_order_seq_cst);
+    if (_has_extra_waiters.load(std::memory_order_seq_cst))
+    {
+      mbed::ScopedLock<rtos::Mutex> lock(_extra_waiters_mutex);
+      _extra_waiters_cond.notify_all();
+    }
+  }
+  if (waiting_thread)
+    osThreadFlagsSet(waiting_thread, IO_RESPONSE_THREAD_FLAG);
+}
+
+inline void IoResponse::prepareWait()
+{
+  reset(nullptr);
+  _is_single_waiter = true;
+  _waiting_thread.store(rtos::ThisThread::get_id(), std::memory_order_seq_cst);
+}
+
+inline void IoResponse::wait()
+{
+  if (isDone())
+    return;
+
+  /* The first thread to wait claims the thread flag based wakeup. */
+  osThreadId_t const current_thread = rtos::ThisThread::get_id();
+  bool is_first_waiter = false;
+  core_util_critical_section_enter();
+  osThreadId_t const waiting_thread = _waiting_thread.load(std::memory_order_seq_cst);
+  if (!waiting_thread || (waiting_thread == current_thread))
+  {
+    _waiting_thread.store(current_thread, std::memory_order_seq_cst);
+    is_first_waiter = true;
+  }
+  core_util_critical_section_exit();
+
+  if (is_first_waiter)
+  {
+    while (!_is_done.load(std::memory_order_seq_cst))
+      rtos::ThisThread::flags_wait_any(IO_RESPONSE_THREAD_FLAG);
+    _waiting_thread.store(nullptr, std::memory_order_relaxed);
+    return;
+  }
+
+  /* Any further thread registers itself before checking for completion
+   * while done() does the opposite, the lock held in between ensures
+   * that a notification issued by done() is not missed.
+   */
+  MBED_ASSERT(!_is_single_waiter);
+  mbed::ScopedLock<rtos::Mutex> lock(_extra_waiters_mutex);
+  _has_extra_waiters.store(true, std::memory_order_seq_cst);
+  while (!_is_done.load(std::memory_order_seq_cst))
+    _extra_waiters_cond.wait();
+}
+
+/**************************************************************************************
+ * IoResponse PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+inline void IoResponse::reset(IoCompletionCallback const & on_complete)
+{
+  bytes_written = 0;
+  bytes_read = 0;
+  queueing_delay = rtos::Kernel::Clock::duration{0};
+  deadline_missed = false;
+  status = IoStatus::Ok;
+  _is_done.store(false, std::memory_order_relaxed);
+  _waiting_thread.store(nullptr, std::memory_order_relaxed);
+  _has_extra_waiters.store(false, std::memory_order_relaxed);
+  _is_single_waiter = false;
+  _on_complete = on_complete;
+}
+
+} /* namespace impl */
 
 /**************************************************************************************
  * IoTransaction
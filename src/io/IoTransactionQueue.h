@@ -0,0 +1,204 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef IO_TRANSACTION_QUEUE_H_
+#define IO_TRANSACTION_QUEUE_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <mbed.h>
+
+#include <type_traits>
+
+#include "IoTransaction.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace impl
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Replaces the rtos::Mail used by the dispatchers: provides raw memory for
+ * SIZE transactions of type T, just as rtos::Mail does, but keeps one FIFO
+ * per IoPriority level. get() always returns the oldest transaction of the
+ * highest priority level which is not empty.
+ */
+template <typename T, size_t SIZE>
+class IoTransactionQueue
+{
+public:
+
+  IoTransactionQueue();
+
+  IoTransactionQueue(IoTransactionQueue const &) = delete;
+  IoTransactionQueue & operator = (IoTransactionQueue const &) = delete;
+
+  T * try_alloc_until(rtos::Kernel::Clock::time_point const deadline);
+  void put(T * t, IoPriority const priority);
+  T * try_get();
+  T * try_get_for(rtos::Kernel::Clock::duration_u32 const rel_time);
+  void free(T * t);
+
+
+private:
+
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Block;
+
+  static size_t constexpr NONE = SIZE;
+
+  Block _block[SIZE];
+  size_t _next[SIZE];
+  size_t _free_head;
+  size_t _head[IO_PRIORITY_NUM_LEVELS];
+  size_t _tail[IO_PRIORITY_NUM_LEVELS];
+
+  rtos::Mutex _mutex;
+  rtos::ConditionVariable _cond_transaction_available;
+  rtos::ConditionVariable _cond_block_available;
+
+  size_t index(T const * t) const { return static_cast<size_t>(reinterpret_cast<Block const *>(t) - _block); }
+  T * get();
+  T * alloc();
+};
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+template <typename T, size_t SIZE>
+IoTransactionQueue<T,SIZE>::IoTransactionQueue()
+: _free_head{0}
+, _cond_transaction_available(_mutex)
+, _cond_block_available(_mutex)
+{
+  for (size_t i = 0; i < SIZE; i++)
+    _next[i] = i + 1;
+  _next[SIZE - 1] = NONE;
+  for (size_t p = 0; p < IO_PRIORITY_NUM_LEVELS; p++)
+    _head[p] = _tail[p] = NONE;
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+template <typename T, size_t SIZE>
+T * IoTransactionQueue<T,SIZE>::try_alloc_until(rtos::Kernel::Clock::time_point const deadline)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  T * t = nullptr;
+  while ((t = alloc()) == nullptr)
+  {
+    if (deadline <= rtos::Kernel::Clock::now())
+      return nullptr;
+    if (deadline == rtos::Kernel::Clock::time_point::max())
+      _cond_block_available.wait();
+    else
+      _cond_block_available.wait_until(deadline);
+  }
+  return t;
+}
+
+template <typename T, size_t SIZE>
+void IoTransactionQueue<T,SIZE>::put(T * t, IoPriority const priority)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  size_t const p = static_cast<size_t>(priority);
+  size_t const idx = index(t);
+  _next[idx] = NONE;
+  if (_tail[p] == NONE)
+    _head[p] = idx;
+  else
+    _next[_tail[p]] = idx;
+  _tail[p] = idx;
+  _cond_transaction_available.notify_one();
+}
+
+template <typename T, size_t SIZE>
+T * IoTransactionQueue<T,SIZE>::try_get()
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  return get();
+}
+
+template <typename T, size_t SIZE>
+T * IoTransactionQueue<T,SIZE>::try_get_for(rtos::Kernel::Clock::duration_u32 const rel_time)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  auto const deadline = rtos::Kernel::Clock::now() + rel_time;
+  T * t = nullptr;
+  while ((t = get()) == nullptr)
+  {
+    if (rel_time == rtos::Kernel::wait_for_u32_forever)
+      _cond_transaction_available.wait();
+    else if (_cond_transaction_available.wait_until(deadline))
+      return get();
+  }
+  return t;
+}
+
+template <typename T, size_t SIZE>
+void IoTransactionQueue<T,SIZE>::free(T * t)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  size_t const idx = index(t);
+  _next[idx] = _free_head;
+  _free_head = idx;
+  _cond_block_available.notify_one();
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+template <typename T, size_t SIZE>
+T * IoTransactionQueue<T,SIZE>::get()
+{
+  for (size_t p = IO_PRIORITY_NUM_LEVELS; p-- > 0; )
+  {
+    if (_head[p] == NONE)
+      continue;
+    size_t const idx = _head[p];
+    _head[p] = _next[idx];
+    if (_head[p] == NONE)
+      _tail[p] = NONE;
+    return reinterpret_cast<T *>(&_block[idx]);
+  }
+  return nullptr;
+}
+
+template <typename T, size_t SIZE>
+T * IoTransactionQueue<T,SIZE>::alloc()
+{
+  if (_free_head == NONE)
+    return nullptr;
+  size_t const idx = _free_head;
+  _free_head = _next[idx];
+  return reinterpret_cast<T *>(&_block[idx]);
+}
+
+} /* namespace impl */
+
+#endif /* IO_TRANSACTION_QUEUE_H_ */
@@ -22,6 +22,13 @@
 
 #include "SerialDispatcher.h"
 
+/**************************************************************************************
+ * STATIC MEMBER DEFINITION
+ **************************************************************************************/
+
+uint32_t constexpr SerialDispatcher::THREADSAFE_SERIAL_RECEIVE_POLL_PERIOD_ms;
+uint32_t constexpr SerialDispatcher::THREADSAFE_SERIAL_RECEIVE_IDLE_POLL_PERIOD_ms;
+
 /**************************************************************************************
  * CTOR/DTOR
  **************************************************************************************/
@@ -33,8 +40,15 @@ SerialDispatcher::SerialDispatcher(arduino::HardwareSerial & serial)
 , _thread(osPriorityRealtime, 4096, nullptr, "SerialDispatcher")
 , _has_tread_started{false}
 , _terminate_thread{false}
+, _injector_mutex{}
 , _global_prefix_callback{nullptr}
 , _global_suffix_callback{nullptr}
+, _global_prefix_writer{nullptr}
+, _global_suffix_writer{nullptr}
+, _num_waiting_readers{0}
+, _customer_table{}
+, _retired_customer_list{}
+, _num_customer_accesses{0}
 {
 
 }
@@ -49,6 +63,11 @@ void SerialDispatcher::begin(unsigned long baudrate)
 }
 
 void SerialDispatcher::begin(unsigned long baudrate, uint16_t config)
+{
+  begin(baudrate, config, THREADSAFE_SERIAL_TRANSMIT_RINGBUFFER_SIZE);
+}
+
+void SerialDispatcher::begin(unsigned long baudrate, uint16_t config, size_t const tx_buffer_size)
 {
   mbed::ScopedLock<rtos::Mutex> lock(_mutex);
 
@@ -62,38 +81,51 @@ void SerialDispatcher::begin(unsigned long baudrate, uint16_t config)
 
   /* Check if the thread calling begin is already in the list. */
   osThreadId_t const current_thread_id = rtos::ThisThread::get_id();
-  if (findThreadCustomerDataById(rtos::ThisThread::get_id()) == std::end(_thread_customer_list))
+  if (!findThreadCustomerData(current_thread_id))
   {
     /* Since the thread is not in the list yet we are
      * going to create a new entry to the list.
      */
-    uint32_t const thread_event_flag = (1<<(_thread_customer_list.size()));
-    ThreadCustomerData data{current_thread_id, thread_event_flag};
-    _thread_customer_list.push_back(data);
+    uint32_t used_event_flags = 0;
+    for (auto const & d : _thread_customer_list)
+      used_event_flags |= d.thread_event_flag;
+    uint32_t thread_event_flag = 1;
+    while (used_event_flags & thread_event_flag)
+      thread_event_flag <<= 1;
+    _thread_customer_list.emplace_back(current_thread_id, thread_event_flag, tx_buffer_size);
+    insertThreadCustomerData(_thread_customer_list.back());
   }
 }
 
 void SerialDispatcher::end()
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  bool terminate_thread = false;
+  {
+    mbed::ScopedLock<rtos::Mutex> lock(_mutex);
 
-  /* Retrieve the current thread ID and remove
-   * the thread data from the thread data list.
-   */
-  osThreadId_t const current_thread_id = rtos::ThisThread::get_id();
-  std::remove_if(std::begin(_thread_customer_list),
-                 std::end  (_thread_customer_list),
-                 [current_thread_id](ThreadCustomerData const d) -> bool
-                 {
-                   return (d.thread_id == current_thread_id);
-                 });
-
-  /* If no thread consumers are left also end
-   * the serial device altogether.
-   */
-  if (_thread_customer_list.size() == 0)
+    /* Retrieve the current thread ID and mark the thread data
+     * as ended. It is removed from the thread data list by the
+     * worker thread as soon as all its data has been transmitted.
+     */
+    ThreadCustomerData * d = findThreadCustomerData(rtos::ThisThread::get_id());
+    if (!d)
+      return;
+    d->is_ended = true;
+
+    /* If no thread consumers are left also end
+     * the serial device altogether.
+     */
+    terminate_thread = std::all_of(std::begin(_thread_customer_list),
+                                   std::end  (_thread_customer_list),
+                                   [](ThreadCustomerData const & d) -> bool { return d.is_ended; });
+    if (terminate_thread)
+      _terminate_thread = true;
+
+    _data_available_for_transmit.set(d->thread_event_flag);
+  }
+
+  if (terminate_thread)
   {
-    _terminate_thread = true;
     _thread.join();
     _serial.end();
   }
@@ -101,38 +133,87 @@ void SerialDispatcher::end()
 
 int SerialDispatcher::available()
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  CurrentCustomer d(*this);
+  assert(d);
 
-  prepareSerialReader(iter);
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  prepareSerialReader(*d);
   handleSerialReader();
 
-  return iter->rx_buffer->available();
+  return d->rx_buffer->available();
 }
 
 int SerialDispatcher::peek()
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  CurrentCustomer d(*this);
+  assert(d);
 
-  prepareSerialReader(iter);
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  prepareSerialReader(*d);
   handleSerialReader();
 
-  return iter->rx_buffer->peek();
+  return d->rx_buffer->peek();
 }
 
 int SerialDispatcher::read()
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  CurrentCustomer d(*this);
+  assert(d);
 
-  prepareSerialReader(iter);
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  prepareSerialReader(*d);
   handleSerialReader();
 
-  return iter->rx_buffer->read_char();
+  return d->rx_buffer->read_char();
+}
+
+size_t SerialDispatcher::readBytes(char * buffer, size_t length)
+{
+  CurrentCustomer d(*this);
+  assert(d);
+
+  auto const deadline = rtos::Kernel::Clock::now() + std::chrono::milliseconds(_timeout);
+  size_t bytes_read = 0;
+  while (bytes_read < length)
+  {
+    {
+      mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+      prepareSerialReader(*d);
+      handleSerialReader();
+
+      while ((bytes_read < length) && d->rx_buffer->available())
+        buffer[bytes_read++] = static_cast<char>(d->rx_buffer->read_char());
+    }
+
+    if (bytes_read == length)
+      break;
+
+    auto const now = rtos::Kernel::Clock::now();
+    if (now >= deadline)
+      break;
+
+    /* Sleep until the dispatcher thread signals (via the event
+     * flag of this thread) that it has received new data. The
+     * dispatcher thread is woken up after registering as waiting
+     * reader so that it switches from the idle to the regular
+     * poll period.
+     */
+    core_util_atomic_incr_u32(&_num_waiting_readers, 1);
+    _data_available_for_transmit.set(d->thread_event_flag);
+    _data_available_for_receive.wait_any_for(d->thread_event_flag, impl::remainingUntil(deadline, now));
+    core_util_atomic_decr_u32(&_num_waiting_readers, 1);
+  }
+
+  return bytes_read;
+}
+
+size_t SerialDispatcher::rxOverflowCount()
+{
+  CurrentCustomer d(*this);
+  assert(d);
+
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  return d->rx_overflow_count;
 }
 
 void SerialDispatcher::flush()
@@ -148,72 +229,123 @@ size_t SerialDispatcher::write(uint8_t const b)
 
 size_t SerialDispatcher::write(const uint8_t * data, size_t len)
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  /* Only the transmit buffer of the calling thread is accessed, which
+   * is a lock-free queue between this thread and the dispatcher thread.
+   */
+  CurrentCustomer d(*this);
+  assert(d);
 
-  size_t bytes_written = 0;
-  for (; (bytes_written < len) && iter->tx_buffer.availableForStore(); bytes_written++)
-    iter->tx_buffer.store_char(data[bytes_written]);
+  size_t bytes_written = store(*d, data, len);
 
-  /* Inform the worker thread that new data has
-   * been written to a Serial transmit buffer.
+  if ((bytes_written == len) || (d->write_timeout.count() == 0) || d->block_tx_buffer)
+    return bytes_written;
+
+  /* Wait for the worker thread to signal (via the same event flag, in
+   * reverse direction) that it has freed up space in the transmit buffer.
    */
-  _data_available_for_transmit.set(iter->thread_event_flag);
+  auto const deadline = rtos::Kernel::Clock::now() + d->write_timeout;
+  while (bytes_written < len)
+  {
+    auto const now = rtos::Kernel::Clock::now();
+    if (now >= deadline)
+      break;
+
+    uint32_t const flags = _space_available_for_transmit.wait_any_for(d->thread_event_flag, impl::remainingUntil(deadline, now));
+    if (flags & osFlagsError)
+      break;
+
+    bytes_written += store(*d, data + bytes_written, len - bytes_written);
+  }
 
   return bytes_written;
 }
 
+void SerialDispatcher::setWriteTimeout(rtos::Kernel::Clock::duration_u32 const timeout)
+{
+  CurrentCustomer d(*this);
+  assert(d);
+
+  d->write_timeout = timeout;
+}
+
 void SerialDispatcher::block()
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  CurrentCustomer d(*this);
+  assert(d);
 
-  iter->block_tx_buffer = true;
+  d->block_tx_buffer = true;
 }
 
 void SerialDispatcher::unblock()
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  CurrentCustomer d(*this);
+  assert(d);
 
-  iter->block_tx_buffer = false;
+  d->block_tx_buffer = false;
 
-  _data_available_for_transmit.set(iter->thread_event_flag);
+  _data_available_for_transmit.set(d->thread_event_flag);
 }
 
 void SerialDispatcher::prefix(PrefixInjectorCallbackFunc func)
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  CurrentCustomer d(*this);
+  assert(d);
 
-  iter->prefix_func = func;
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
+  d->prefix_func = func;
 }
 
 void SerialDispatcher::suffix(SuffixInjectorCallbackFunc func)
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  auto iter = findThreadCustomerDataById(rtos::ThisThread::get_id());
-  assert(iter != std::end(_thread_customer_list));
+  CurrentCustomer d(*this);
+  assert(d);
 
-  iter->suffix_func = func;
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
+  d->suffix_func = func;
 }
 
 void SerialDispatcher::globalPrefix(PrefixInjectorCallbackFunc func)
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
   _global_prefix_callback = func;
 }
 
 void SerialDispatcher::globalSuffix(SuffixInjectorCallbackFunc func)
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
   _global_suffix_callback = func;
 }
 
+void SerialDispatcher::prefixWriter(InjectorWriterCallbackFunc func)
+{
+  CurrentCustomer d(*this);
+  assert(d);
+
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
+  d->prefix_writer = func;
+}
+
+void SerialDispatcher::suffixWriter(InjectorWriterCallbackFunc func)
+{
+  CurrentCustomer d(*this);
+  assert(d);
+
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
+  d->suffix_writer = func;
+}
+
+void SerialDispatcher::globalPrefixWriter(InjectorWriterCallbackFunc func)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
+  _global_prefix_writer = func;
+}
+
+void SerialDispatcher::globalSuffixWriter(InjectorWriterCallbackFunc func)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
+  _global_suffix_writer = func;
+}
+
 /**************************************************************************************
  * PRIVATE MEMBER FUNCTIONS
  **************************************************************************************/
@@ -221,115 +353,323 @@ void SerialDispatcher::globalSuffix(SuffixInjectorCallbackFunc func)
 void SerialDispatcher::threadFunc()
 {
   _has_tread_started = true;
+  uint32_t poll_period_ms = osWaitForever;
+  auto last_receive = rtos::Kernel::Clock::now();
 
   while(!_terminate_thread)
   {
-      /* Wait for data to be available in a transmit buffer. */
+      /* Wait for data to be available in a transmit buffer. As long as
+       * there are threads reading from serial, wake up periodically to
+       * move the received data into their receive buffers, independent
+       * of whether or not they are currently calling read()/available().
+       * While the line is quiet and no thread is waiting within
+       * readBytes() this happens at the lower idle rate.
+       */
       static uint32_t constexpr ALL_EVENT_FLAGS = 0x7fffffff;
-      _data_available_for_transmit.wait_any(ALL_EVENT_FLAGS, osWaitForever, /* clear */ true);
+      _data_available_for_transmit.wait_any(ALL_EVENT_FLAGS, poll_period_ms, /* clear */ true);
+
+      /* Iterate over all list entries. The list itself is only
+       * accessed with the lock held since other threads may add
+       * entries at any time. Entries are only removed here.
+       */
+      _mutex.lock();
+      auto const now = rtos::Kernel::Clock::now();
+      if (handleSerialReader())
+        last_receive = now;
+      bool has_serial_reader = false;
+      for (auto iter = std::begin(_thread_customer_list); iter != std::end(_thread_customer_list); )
+      {
+        has_serial_reader |= (iter->rx_buffer && !iter->is_ended);
+        _mutex.unlock();
+        transmit(*iter);
+        _mutex.lock();
+
+        if (iter->is_ended && !iter->tx_buffer.available())
+        {
+          removeThreadCustomerData(*iter);
+          auto const retired = iter++;
+          _retired_customer_list.splice(std::end(_retired_customer_list), _thread_customer_list, retired);
+        }
+        else
+          iter++;
+      }
+
+      /* The table entries of retired customers have already been cleared,
+       * so once no thread is accessing its customer data, none can still
+       * hold a pointer to them.
+       */
+      if (!_retired_customer_list.empty() && (core_util_atomic_load_u32(&_num_customer_accesses) == 0))
+        _retired_customer_list.clear();
+
+      bool const is_line_active = (now - last_receive) < std::chrono::milliseconds(THREADSAFE_SERIAL_RECEIVE_POLL_PERIOD_ms);
+      if (!has_serial_reader)
+        poll_period_ms = osWaitForever;
+      else if (is_line_active || (core_util_atomic_load_u32(&_num_waiting_readers) > 0))
+        poll_period_ms = THREADSAFE_SERIAL_RECEIVE_POLL_PERIOD_ms;
+      else
+        poll_period_ms = THREADSAFE_SERIAL_RECEIVE_IDLE_POLL_PERIOD_ms;
+      _mutex.unlock();
+  }
+}
 
-      /* Iterate over all list entries. */
-      std::for_each(std::begin(_thread_customer_list),
-                    std::end  (_thread_customer_list),
-                    [this](ThreadCustomerData & d)
-                    {
-                      if (d.block_tx_buffer)
-                        return;
-
-                      /* Return if there's no data to be written to the
-                       * serial interface. This statement is necessary
-                       * because otherwise the prefix/suffix functions
-                       * will be invoked and will be printing something,
-                       * even though no data is actually to be printed for
-                       * most threads.
-                       */
-                      if (!d.tx_buffer.available())
-                        return;
-
-                      /* Retrieve all data stored in the transmit ringbuffer
-                       * and store it into a String for usage by both suffix
-                       * prefix callback functions.
-                       */
-                      String msg;
-                      while(d.tx_buffer.available())
-                        msg += static_cast<char>(d.tx_buffer.read_char());
-
-                      /* The prefix callback function allows the
-                       * user to insert a custom message before
-                       * a new message is written to the serial
-                       * driver. This is useful e.g. for wrapping
-                       * protocol (e.g. the 'AT' protocol) or providing
-                       * a timestamp, a log level, ...
-                       */
-                      String prefix;
-                      if (d.prefix_func)
-                        prefix = d.prefix_func(msg);
-                      /* A prefix callback function defined per thread
-                       * takes precedence over a globally defined prefix
-                       * callback function.
-                       */
-                      else if (_global_prefix_callback)
-                        prefix = _global_prefix_callback(msg);
-
-                      /* Similar to the prefix function this callback
-                       * allows the user to specify a specific message
-                       * to be appended to each message, e.g. '\r\n'.
-                       */
-                      String suffix;
-                      if (d.suffix_func)
-                        suffix = d.suffix_func(prefix, msg);
-                      /* A suffix callback function defined per thread
-                       * takes precedence over a globally defined suffix
-                       * callback function.
-                       */
-                      else if (_global_suffix_callback)
-                        suffix = _global_suffix_callback(prefix, msg);
-
-                      /* Now it's time to actually write the message
-                       * conveyed by the user via Serial.print/println.
-                       */
-                      _serial.write(prefix.c_str());
-                      _serial.write(msg.c_str());
-                      _serial.write(suffix.c_str());
-                    });
+void SerialDispatcher::transmit(ThreadCustomerData & d)
+{
+  if (d.block_tx_buffer)
+    return;
+
+  /* Return if there's no data to be written to the
+   * serial interface. This statement is necessary
+   * because otherwise the prefix/suffix functions
+   * will be invoked and will be printing something,
+   * even though no data is actually to be printed for
+   * most threads. Only the data available right now
+   * is transmitted as one message.
+   */
+  size_t const num_bytes = d.tx_buffer.available();
+  if (!num_bytes)
+    return;
+
+  /* The prefix callback function allows the
+   * user to insert a custom message before
+   * a new message is written to the serial
+   * driver. This is useful e.g. for wrapping
+   * protocol (e.g. the 'AT' protocol) or providing
+   * a timestamp, a log level, ... Similar to the
+   * prefix function the suffix callback allows the
+   * user to specify a specific message to be
+   * appended to each message, e.g. '\r\n'.
+   *
+   * A callback function defined per thread takes
+   * precedence over a globally defined callback
+   * function, a String based callback over a writer
+   * callback.
+   *
+   * The callbacks are only referenced (not copied,
+   * which might allocate) so the lock is held until
+   * the whole message has been transmitted.
+   */
+  mbed::ScopedLock<rtos::Mutex> lock(_injector_mutex);
+  PrefixInjectorCallbackFunc const * prefix_func   = nullptr;
+  InjectorWriterCallbackFunc const * prefix_writer = nullptr;
+  if      (d.prefix_func)             prefix_func   = &d.prefix_func;
+  else if (d.prefix_writer)           prefix_writer = &d.prefix_writer;
+  else if (_global_prefix_callback)   prefix_func   = &_global_prefix_callback;
+  else if (_global_prefix_writer)     prefix_writer = &_global_prefix_writer;
+
+  SuffixInjectorCallbackFunc const * suffix_func   = nullptr;
+  InjectorWriterCallbackFunc const * suffix_writer = nullptr;
+  if      (d.suffix_func)             suffix_func   = &d.suffix_func;
+  else if (d.suffix_writer)           suffix_writer = &d.suffix_writer;
+  else if (_global_suffix_callback)   suffix_func   = &_global_suffix_callback;
+  else if (_global_suffix_writer)     suffix_writer = &_global_suffix_writer;
+
+  /* Without String based callbacks the data is written
+   * directly from the transmit ringbuffer.
+   */
+  if (!prefix_func && !suffix_func)
+  {
+    if (prefix_writer) transmitInjection(*prefix_writer);
+    transmitBuffered(d, num_bytes);
+    if (suffix_writer) transmitInjection(*suffix_writer);
+    return;
+  }
+
+  /* The String based callbacks take the message as a whole, so
+   * it is copied into a String, at once, for usage by them.
+   */
+  String msg;
+  msg.reserve(num_bytes);
+  for (size_t copied = 0; copied < num_bytes; )
+  {
+    size_t len = 0;
+    uint8_t const * segment = d.tx_buffer.segment(len);
+    len = std::min(len, num_bytes - copied);
+    msg.concat(reinterpret_cast<char const *>(segment), len);
+    d.tx_buffer.consume(len);
+    copied += len;
+  }
+  _space_available_for_transmit.set(d.thread_event_flag);
+
+  String prefix;
+  if (prefix_func)
+    prefix = (*prefix_func)(msg);
+
+  String suffix;
+  if (suffix_func)
+    suffix = (*suffix_func)(prefix, msg);
+
+  /* Now it's time to actually write the message
+   * conveyed by the user via Serial.print/println.
+   */
+  if (prefix_func)
+    _serial.write(reinterpret_cast<uint8_t const *>(prefix.c_str()), prefix.length());
+  else if (prefix_writer)
+    transmitInjection(*prefix_writer);
+
+  _serial.write(reinterpret_cast<uint8_t const *>(msg.c_str()), msg.length());
+
+  if (suffix_func)
+    _serial.write(reinterpret_cast<uint8_t const *>(suffix.c_str()), suffix.length());
+  else if (suffix_writer)
+    transmitInjection(*suffix_writer);
+}
+
+void SerialDispatcher::transmitBuffered(ThreadCustomerData & d, size_t const num_bytes)
+{
+  /* The buffered data is written in place. This is safe since a writing
+   * thread only ever fills the free space of its transmit buffer, the
+   * segment is released only after it has been sent.
+   */
+  for (size_t sent = 0; sent < num_bytes; )
+  {
+    size_t len = 0;
+    uint8_t const * segment = d.tx_buffer.segment(len);
+    len = std::min(len, num_bytes - sent);
+
+    _serial.write(segment, len);
+
+    d.tx_buffer.consume(len);
+    _space_available_for_transmit.set(d.thread_event_flag);
+    sent += len;
+  }
+}
+
+void SerialDispatcher::transmitInjection(InjectorWriterCallbackFunc const & writer)
+{
+  size_t const len = std::min(writer(_scratch_buf, sizeof(_scratch_buf)), sizeof(_scratch_buf));
+  if (len > 0)
+    _serial.write(_scratch_buf, len);
+}
+
+size_t SerialDispatcher::store(ThreadCustomerData & d, uint8_t const * data, size_t const len)
+{
+  size_t const bytes_stored = d.tx_buffer.store(data, len);
+
+  /* Inform the worker thread that new data has
+   * been written to a Serial transmit buffer.
+   */
+  _data_available_for_transmit.set(d.thread_event_flag);
+
+  return bytes_stored;
+}
+
+SerialDispatcher::ThreadCustomerData * SerialDispatcher::findThreadCustomerData(osThreadId_t const thread_id)
+{
+  /* A probe sequence ends at the first never used table entry. Entries
+   * of removed customers keep their thread ID (with their data pointer
+   * cleared) so that the probe sequences passing them remain intact.
+   */
+  for (size_t n = 0, idx = customerTableIndex(thread_id);
+       n < THREADSAFE_SERIAL_CUSTOMER_TABLE_SIZE;
+       n++, idx = (idx + 1) % THREADSAFE_SERIAL_CUSTOMER_TABLE_SIZE)
+  {
+    osThreadId_t const id = _customer_table[idx].thread_id.load(std::memory_order_seq_cst);
+    if (id == nullptr)
+      return nullptr;
+    if (id == thread_id)
+    {
+      /* An entry reused for another thread gets its thread ID before its
+       * data, re-checking the ID ensures that the data is still ours.
+       */
+      ThreadCustomerData * d = _customer_table[idx].data.load(std::memory_order_seq_cst);
+      if (_customer_table[idx].thread_id.load(std::memory_order_seq_cst) != thread_id)
+        continue;
+      return (d && !d->is_ended) ? d : nullptr;
+    }
   }
+  return nullptr;
 }
 
-std::list<SerialDispatcher::ThreadCustomerData>::iterator SerialDispatcher::findThreadCustomerDataById(osThreadId_t const thread_id)
+void SerialDispatcher::insertThreadCustomerData(ThreadCustomerData & d)
 {
-  return std::find_if(std::begin(_thread_customer_list),
-                      std::end  (_thread_customer_list),
-                      [thread_id](ThreadCustomerData const d) -> bool
-                      {
-                        return (d.thread_id == thread_id);
-                      });
+  /* Reuse the entry of a previous customer with the same thread ID, if
+   * any, or else the first entry which is either unused or was released.
+   */
+  CustomerTableEntry * free_entry = nullptr;
+  for (size_t n = 0, idx = customerTableIndex(d.thread_id);
+       n < THREADSAFE_SERIAL_CUSTOMER_TABLE_SIZE;
+       n++, idx = (idx + 1) % THREADSAFE_SERIAL_CUSTOMER_TABLE_SIZE)
+  {
+    CustomerTableEntry & e = _customer_table[idx];
+    osThreadId_t const id = e.thread_id.load(std::memory_order_relaxed);
+    if (id == d.thread_id)
+    {
+      e.data.store(&d, std::memory_order_release);
+      return;
+    }
+    if (!free_entry && !e.data.load(std::memory_order_relaxed))
+      free_entry = &e;
+    if (id == nullptr)
+      break;
+  }
+
+  /* The thread ID is published before the data, see findThreadCustomerData(). */
+  assert(free_entry);
+  free_entry->thread_id.store(d.thread_id, std::memory_order_seq_cst);
+  free_entry->data.store(&d, std::memory_order_seq_cst);
+}
+
+void SerialDispatcher::removeThreadCustomerData(ThreadCustomerData & d)
+{
+  for (CustomerTableEntry & e : _customer_table)
+  {
+    if (e.data.load(std::memory_order_relaxed) == &d)
+      e.data.store(nullptr, std::memory_order_seq_cst);
+  }
+}
+
+size_t SerialDispatcher::customerTableIndex(osThreadId_t const thread_id)
+{
+  /* Fibonacci hashing of the thread control block address. */
+  uint32_t const hash = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(thread_id) >> 3) * 2654435761UL;
+  return (hash >> 16) % THREADSAFE_SERIAL_CUSTOMER_TABLE_SIZE;
 }
 
-void SerialDispatcher::prepareSerialReader(std::list<ThreadCustomerData>::iterator & iter)
+void SerialDispatcher::prepareSerialReader(ThreadCustomerData & d)
 {
-  if (!iter->rx_buffer)
-    iter->rx_buffer.reset(new arduino::RingBuffer());
+  if (!d.rx_buffer)
+  {
+    d.rx_buffer.reset(new arduino::RingBuffer());
+    /* Wake up the dispatcher thread so that it starts
+     * to periodically pump the received data.
+     */
+    _data_available_for_transmit.set(d.thread_event_flag);
+  }
 }
 
-void SerialDispatcher::handleSerialReader()
+bool SerialDispatcher::handleSerialReader()
 {
+  uint32_t readers_to_notify = 0;
+  bool has_received_data = false;
+
   while (_serial.available())
   {
     int const c = _serial.read();
+    has_received_data = true;
 
     std::for_each(std::begin(_thread_customer_list),
                   std::end  (_thread_customer_list),
-                  [c](ThreadCustomerData & d)
+                  [c, &readers_to_notify](ThreadCustomerData & d)
                   {
-                    if (!d.rx_buffer)
+                    if (!d.rx_buffer || d.is_ended)
                       return;
 
                     if (!d.rx_buffer->availableForStore())
+                    {
+                      d.rx_overflow_count++;
                       return;
+                    }
 
                     d.rx_buffer->store_char(c);
+                    readers_to_notify |= d.thread_event_flag;
                   });
   }
+
+  /* Wake up any thread waiting within readBytes(). */
+  if (readers_to_notify)
+    _data_available_for_receive.set(readers_to_notify);
+
+  return has_received_data;
 }
 
 /**************************************************************************************
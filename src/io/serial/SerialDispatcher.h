@@ -28,10 +28,14 @@
 #include <mbed.h>
 
 #include <list>
+#include <atomic>
 #include <functional>
 
 #include <SharedPtr.h>
 
+#include "SerialTransmitBuffer.h"
+#include "../../threading/Deadline.hpp"
+
 /**************************************************************************************
  * CLASS DECLARATION
  **************************************************************************************/
@@ -46,6 +50,11 @@ public:
 
   virtual void begin(unsigned long baudrate) override;
   virtual void begin(unsigned long baudrate, uint16_t config) override;
+  /* The size of the transmit buffer of the calling thread is determined
+   * by its first call to begin(), THREADSAFE_SERIAL_TRANSMIT_RINGBUFFER_SIZE
+   * bytes if not specified.
+   */
+  void begin(unsigned long baudrate, uint16_t config, size_t const tx_buffer_size);
   virtual void end() override;
   virtual int available() override;
   virtual int peek() override;
@@ -56,9 +65,34 @@ public:
   using Print::write;
   virtual operator bool() override { return _serial; }
 
+  /* Waits for up to the Stream timeout (see setTimeout()) until 'length'
+   * bytes have been received, sleeping instead of polling in the meantime.
+   * Returns the number of bytes read.
+   *
+   * Note: Stream::readBytes() is not virtual, these overloads only hide it.
+   * When called through a Stream & or HardwareSerial & reference Stream's
+   * implementation is used instead, which busy-polls read() until the
+   * timeout expires.
+   */
+  size_t readBytes(char * buffer, size_t length);
+  size_t readBytes(uint8_t * buffer, size_t length) { return readBytes(reinterpret_cast<char *>(buffer), length); }
+
+  /* Number of received bytes the calling thread has missed
+   * because its receive buffer was full at the time.
+   */
+  size_t rxOverflowCount();
+
   void block();
   void unblock();
 
+  /* By default write() stores only as much data as fits into the transmit
+   * buffer of the calling thread and returns the number of bytes stored.
+   * With a timeout it waits for the dispatcher to free up space until
+   * either all data is stored or the timeout expires. Data written while
+   * the transmit buffer is blocked (see block()) is never waited for.
+   */
+  void setWriteTimeout(rtos::Kernel::Clock::duration_u32 const timeout);
+
   typedef std::function<String(String const &)> PrefixInjectorCallbackFunc;
   typedef std::function<String(String const &, String const &)>  SuffixInjectorCallbackFunc;
   void prefix(PrefixInjectorCallbackFunc func);
@@ -66,52 +100,155 @@ public:
   void globalPrefix(PrefixInjectorCallbackFunc func);
   void globalSuffix(SuffixInjectorCallbackFunc func);
 
+  /* Allocation free alternative to the String based callbacks above for
+   * prefixes/suffixes which do not depend on the message itself: the
+   * callback writes at most 'len' bytes into 'buf' (a scratch buffer of
+   * the dispatcher) and returns the number of bytes written.
+   */
+  typedef std::function<size_t(uint8_t * buf, size_t const len)> InjectorWriterCallbackFunc;
+  void prefixWriter(InjectorWriterCallbackFunc func);
+  void suffixWriter(InjectorWriterCallbackFunc func);
+  void globalPrefixWriter(InjectorWriterCallbackFunc func);
+  void globalSuffixWriter(InjectorWriterCallbackFunc func);
+
 
 private:
 
   bool _is_initialized;
   rtos::Mutex _mutex;
   rtos::EventFlags _data_available_for_transmit;
+  rtos::EventFlags _space_available_for_transmit;
+  rtos::EventFlags _data_available_for_receive;
   arduino::HardwareSerial & _serial;
 
   rtos::Thread _thread;
   bool _has_tread_started;
   bool _terminate_thread;
 
+  /* Guards all prefix/suffix callbacks, both per thread and global. The
+   * dispatcher thread holds it while transmitting, so a callback cannot be
+   * replaced while it is being invoked. Separate from _mutex so that other
+   * threads can begin()/end() while a (possibly slow) callback runs.
+   */
+  rtos::Mutex _injector_mutex;
   PrefixInjectorCallbackFunc _global_prefix_callback;
   SuffixInjectorCallbackFunc _global_suffix_callback;
+  InjectorWriterCallbackFunc _global_prefix_writer;
+  InjectorWriterCallbackFunc _global_suffix_writer;
 
-  static int constexpr THREADSAFE_SERIAL_TRANSMIT_RINGBUFFER_SIZE = 128;
-  typedef arduino::RingBufferN<THREADSAFE_SERIAL_TRANSMIT_RINGBUFFER_SIZE> SerialTransmitRingbuffer;
+  static size_t constexpr THREADSAFE_SERIAL_TRANSMIT_RINGBUFFER_SIZE = 128;
+  /* Interval at which the dispatcher thread moves received data into the
+   * receive buffers of the reading threads, as long as there are any.
+   * The shorter period applies while a thread is waiting within readBytes()
+   * or data has arrived during the last period. Otherwise the longer idle
+   * period is used to let the MCU sleep, it must be short enough for the
+   * serial driver's receive buffer not to overflow in the meantime.
+   */
+  static uint32_t constexpr THREADSAFE_SERIAL_RECEIVE_POLL_PERIOD_ms = 5;
+  static uint32_t constexpr THREADSAFE_SERIAL_RECEIVE_IDLE_POLL_PERIOD_ms = 20;
+  volatile uint32_t _num_waiting_readers;
+  typedef impl::SerialTransmitBuffer SerialTransmitRingbuffer;
+
+  /* Target of the prefix/suffix writer callbacks, only
+   * accessed from within the dispatcher thread.
+   */
+  static size_t constexpr THREADSAFE_SERIAL_SCRATCH_BUFFER_SIZE = 64;
+  uint8_t _scratch_buf[THREADSAFE_SERIAL_SCRATCH_BUFFER_SIZE];
 
   class ThreadCustomerData
   {
   public:
-    ThreadCustomerData(osThreadId_t const t, uint32_t const t_event_flag)
+    ThreadCustomerData(osThreadId_t const t, uint32_t const t_event_flag, size_t const tx_buffer_size)
     : thread_id{t}
     , thread_event_flag{t_event_flag}
-    , tx_buffer{}
+    , tx_buffer{tx_buffer_size}
     , block_tx_buffer{false}
+    , write_timeout{0}
+    , is_ended{false}
     , rx_buffer{}
+    , rx_overflow_count{0}
     , prefix_func{nullptr}
     , suffix_func{nullptr}
+    , prefix_writer{nullptr}
+    , suffix_writer{nullptr}
     { }
 
     osThreadId_t thread_id;
     uint32_t thread_event_flag;
     SerialTransmitRingbuffer tx_buffer;
-    bool block_tx_buffer;
+    std::atomic<bool> block_tx_buffer;
+    rtos::Kernel::Clock::duration_u32 write_timeout; /* Only accessed by the thread itself. */
+    std::atomic<bool> is_ended; /* end() has been called by the thread. */
     mbed::SharedPtr<arduino::RingBuffer> rx_buffer; /* Only when a thread has expressed interested to read from serial a receive ringbuffer is allocated. */
+    size_t rx_overflow_count;
     PrefixInjectorCallbackFunc prefix_func;
     SuffixInjectorCallbackFunc suffix_func;
+    InjectorWriterCallbackFunc prefix_writer;
+    InjectorWriterCallbackFunc suffix_writer;
   };
 
   std::list<ThreadCustomerData> _thread_customer_list;
 
+  /* Hash table (open addressing, linear probing) mapping the thread ID
+   * of each customer thread to its entry in _thread_customer_list. It is
+   * read without holding any lock, so that a thread resolves its own
+   * customer data in constant time without contending for _mutex. It is
+   * only ever modified with _mutex held. There are at most 31 customer
+   * threads (one event flag per thread) so the table is never full.
+   */
+  class CustomerTableEntry
+  {
+  public:
+    std::atomic<osThreadId_t> thread_id;
+    std::atomic<ThreadCustomerData *> data;
+  };
+  static size_t constexpr THREADSAFE_SERIAL_CUSTOMER_TABLE_SIZE = 64;
+  CustomerTableEntry _customer_table[THREADSAFE_SERIAL_CUSTOMER_TABLE_SIZE];
+
+  /* Customer data erased from _thread_customer_list is only freed once
+   * no thread is within a CurrentCustomer scope, since a thread may have
+   * looked it up just before it was erased.
+   */
+  std::list<ThreadCustomerData> _retired_customer_list;
+  volatile uint32_t _num_customer_accesses;
+
+  /* Resolves the customer data of the calling thread without taking
+   * _mutex, the data remains valid as long as this object exists.
+   */
+  class CurrentCustomer
+  {
+  public:
+    CurrentCustomer(SerialDispatcher & dispatcher)
+    : _dispatcher(dispatcher)
+    {
+      core_util_atomic_incr_u32(&_dispatcher._num_customer_accesses, 1);
+      _data = _dispatcher.findThreadCustomerData(rtos::ThisThread::get_id());
+    }
+    ~CurrentCustomer() { core_util_atomic_decr_u32(&_dispatcher._num_customer_accesses, 1); }
+
+    CurrentCustomer(CurrentCustomer const &) = delete;
+    CurrentCustomer & operator = (CurrentCustomer const &) = delete;
+
+    inline ThreadCustomerData * operator -> () const { return _data; }
+    inline ThreadCustomerData & operator *  () const { return *_data; }
+    inline explicit operator bool() const { return (_data != nullptr); }
+
+  private:
+    SerialDispatcher & _dispatcher;
+    ThreadCustomerData * _data;
+  };
+
   void threadFunc();
-  std::list<ThreadCustomerData>::iterator findThreadCustomerDataById(osThreadId_t const thread_id);
-  void prepareSerialReader(std::list<ThreadCustomerData>::iterator & iter);
-  void handleSerialReader();
+  void transmit(ThreadCustomerData & d);
+  void transmitBuffered(ThreadCustomerData & d, size_t const num_bytes);
+  void transmitInjection(InjectorWriterCallbackFunc const & writer);
+  size_t store(ThreadCustomerData & d, uint8_t const * data, size_t const len);
+  ThreadCustomerData * findThreadCustomerData(osThreadId_t const thread_id);
+  void insertThreadCustomerData(ThreadCustomerData & d);
+  void removeThreadCustomerData(ThreadCustomerData & d);
+  static size_t customerTableIndex(osThreadId_t const thread_id);
+  void prepareSerialReader(ThreadCustomerData & d);
+  bool handleSerialReader();
 };
 
 /**************************************************************************************
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef SERIAL_TRANSMIT_BUFFER_H_
+#define SERIAL_TRANSMIT_BUFFER_H_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <Arduino.h>
+
+#include <atomic>
+#include <memory>
+#include <algorithm>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace impl
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Transmit ringbuffer of a SerialDispatcher customer thread. As opposed
+ * to arduino::RingBufferN the buffered data can be accessed in place,
+ * i.e. as (at most two) contiguous segments, which allows to pass it
+ * directly to HardwareSerial::write() without copying it first. The
+ * capacity is chosen per thread and rounded up to a power of two.
+ *
+ * The buffer is a lock-free single producer (the customer thread calling
+ * store()) single consumer (the dispatcher thread calling segment() and
+ * consume()) queue: each index is written by one side only and published
+ * to the other side with release/acquire semantics.
+ */
+class SerialTransmitBuffer
+{
+public:
+
+  SerialTransmitBuffer(size_t const capacity)
+  : _size{roundUpToPowerOfTwo(capacity)}
+  , _buf{new uint8_t[_size]}
+  , _head{0}
+  , _tail{0}
+  { }
+
+  inline size_t capacity         () const { return _size; }
+  inline size_t available        () const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+  inline size_t availableForStore() const { return _size - available(); }
+
+  /* Producer: stores as much of 'data' as fits, returns the number of bytes stored. */
+  size_t store(uint8_t const * data, size_t const len)
+  {
+    size_t const head = _head.load(std::memory_order_relaxed);
+    size_t const tail = _tail.load(std::memory_order_acquire);
+    size_t const num = std::min(len, _size - (head - tail));
+    size_t const head_idx = head & (_size - 1);
+    size_t const first = std::min(num, _size - head_idx);
+    memcpy(_buf.get() + head_idx, data, first);
+    memcpy(_buf.get(), data + first, num - first);
+    _head.store(head + num, std::memory_order_release);
+    return num;
+  }
+
+  /* Consumer: returns the oldest contiguous segment of buffered
+   * data and its length, data remains buffered until consume().
+   */
+  uint8_t const * segment(size_t & len) const
+  {
+    size_t const tail = _tail.load(std::memory_order_relaxed);
+    size_t const head = _head.load(std::memory_order_acquire);
+    size_t const tail_idx = tail & (_size - 1);
+    len = std::min(head - tail, _size - tail_idx);
+    return _buf.get() + tail_idx;
+  }
+
+  /* Consumer: releases the space of 'len' bytes to the producer. */
+  inline void consume(size_t const len)
+  {
+    _tail.store(_tail.load(std::memory_order_relaxed) + len, std::memory_order_release);
+  }
+
+
+private:
+
+  size_t _size;
+  std::unique_ptr<uint8_t[]> _buf;
+  /* Free running, masked on access. */
+  std::atomic<size_t> _head; /* Written by the producer only. */
+  std::atomic<size_t> _tail; /* Written by the consumer only. */
+
+  static size_t roundUpToPowerOfTwo(size_t const val)
+  {
+    size_t size = 1;
+    while (size < val)
+      size <<= 1;
+    return size;
+  }
+};
+
+} /* namespace impl */
+
+#endif /* SERIAL_TRANSMIT_BUFFER_H_ */
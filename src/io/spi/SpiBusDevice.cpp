@@ -38,33 +38,59 @@ SpiBusDevice::SpiBusDevice(SpiBusDeviceConfig const & config)
  * PUBLIC MEMBER FUNCTIONS
  **************************************************************************************/
 
-IoResponse SpiBusDevice::transfer(IoRequest & req)
+IoResponse SpiBusDevice::transfer(IoRequest & req, IoCompletionCallback on_complete)
 {
-  return SpiDispatcher::instance().dispatch(&req, &_config);
+  return SpiDispatcher::instance(_config.spi()).dispatch(&req, &_config, on_complete);
+}
+
+void SpiBusDevice::transferAndWait(IoRequest & req, IoResult & result)
+{
+  SpiDispatcher::instance(_config.spi()).dispatchAndWait(&req, &_config, result);
+}
+
+void SpiBusDevice::setKeepCsAsserted(bool const keep_cs_asserted)
+{
+  _config.setKeepCsAsserted(keep_cs_asserted);
 }
 
 bool SpiBusDevice::read(uint8_t * buffer, size_t len, uint8_t sendvalue)
 {
-  SpiBusDeviceConfig config(_config.spi(), _config.settings(), _config.selectFunc(), _config.deselectFunc(), sendvalue);
   IoRequest req(nullptr, 0, buffer, len);
-  IoResponse rsp = SpiDispatcher::instance().dispatch(&req, &config);
-  rsp->wait();
-  return true;
+  return dispatchAndWait(req, sendvalue);
 }
 
 bool SpiBusDevice::write(uint8_t * buffer, size_t len)
 {
   IoRequest req(buffer, len, nullptr, 0);
-  IoResponse rsp = SpiDispatcher::instance().dispatch(&req, &_config);
-  rsp->wait();
-  return true;
+  return dispatchAndWait(req, _config.fillSymbol());
 }
 
 bool SpiBusDevice::writeThenRead(uint8_t * write_buffer, size_t write_len, uint8_t * read_buffer, size_t read_len, uint8_t sendvalue)
 {
-  SpiBusDeviceConfig config(_config.spi(), _config.settings(), _config.selectFunc(), _config.deselectFunc(), sendvalue);
   IoRequest req(write_buffer, write_len, read_buffer, read_len);
-  IoResponse rsp = SpiDispatcher::instance().dispatch(&req, &config);
-  rsp->wait();
-  return true;
+  return dispatchAndWait(req, sendvalue);
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool SpiBusDevice::dispatchAndWait(IoRequest & req, uint8_t const fill_symbol)
+{
+  IoResult result;
+
+  /* A copy of the device configuration is only required
+   * if the fill symbol differs from the configured one.
+   */
+  if (fill_symbol == _config.fillSymbol())
+  {
+    SpiDispatcher::instance(_config.spi()).dispatchAndWait(&req, &_config, result);
+  }
+  else
+  {
+    SpiBusDeviceConfig config(_config, fill_symbol);
+    SpiDispatcher::instance(_config.spi()).dispatchAndWait(&req, &config, result);
+  }
+
+  return (result.status == IoStatus::Ok);
 }
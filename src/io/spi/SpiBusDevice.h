@@ -39,18 +39,27 @@ public:
   virtual ~SpiBusDevice() { }
 
 
-  virtual IoResponse transfer(IoRequest & req) override;
+  virtual IoResponse transfer(IoRequest & req, IoCompletionCallback on_complete = nullptr) override;
+  virtual void transferAndWait(IoRequest & req, IoResult & result) override;
 
 
+  /* Return false if the request failed, transfer() provides the
+   * IoStatus and the number of bytes transferred.
+   */
   bool read(uint8_t * buffer, size_t len, uint8_t sendvalue = 0xFF);
   bool write(uint8_t * buffer, size_t len);
   bool writeThenRead(uint8_t * write_buffer, size_t write_len, uint8_t * read_buffer, size_t read_len, uint8_t sendvalue = 0xFF);
 
+  /* See SpiBusDeviceConfig::keepCsAsserted(). */
+  void setKeepCsAsserted(bool const keep_cs_asserted);
+
 
 private:
 
   SpiBusDeviceConfig _config;
 
+  bool dispatchAndWait(IoRequest & req, uint8_t const fill_symbol);
+
 };
 
 #endif /* SPI_BUS_DEVICE_H_ */
@@ -57,7 +57,15 @@ public:
      [cs_pin](){ digitalWrite(cs_pin, HIGH); },
      fill_symbol
     }
-  { }
+  {
+    _cs_pin = cs_pin;
+  }
+
+  SpiBusDeviceConfig(SpiBusDeviceConfig const & other, byte const fill_symbol)
+  : SpiBusDeviceConfig{other}
+  {
+    _fill_symbol = fill_symbol;
+  }
 
 
   arduino::HardwareSPI & spi() { return _spi; }
@@ -69,6 +77,17 @@ public:
   SpiSelectFunc   selectFunc  () const { return _spi_select;  }
   SpiDeselectFunc deselectFunc() const { return _spi_deselect;  }
 
+  /* Only known if the chip select is controlled via the cs_pin
+   * constructor, -1 for custom select/deselect functions.
+   */
+  int         csPin         () const { return _cs_pin; }
+  /* If set the dispatcher may keep the chip select asserted between
+   * back-to-back requests to this device. Do not set this for devices
+   * which require a chip select edge in order to complete a command.
+   */
+  bool        keepCsAsserted() const { return _keep_cs_asserted; }
+  void        setKeepCsAsserted(bool const keep_cs_asserted) { _keep_cs_asserted = keep_cs_asserted; }
+
 private:
 
   arduino::HardwareSPI & _spi;
@@ -76,6 +95,8 @@ private:
   SpiSelectFunc _spi_select{nullptr};
   SpiDeselectFunc _spi_deselect{nullptr};
   byte _fill_symbol{0xFF};
+  int _cs_pin{-1};
+  bool _keep_cs_asserted{false};
 
 };
 
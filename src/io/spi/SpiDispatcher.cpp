@@ -22,24 +22,32 @@
 
 #include "SpiDispatcher.h"
 
+#include <new>
+#include <algorithm>
+
 #include <SPI.h>
 
 /**************************************************************************************
  * STATIC MEMBER DEFINITION
  **************************************************************************************/
 
-SpiDispatcher * SpiDispatcher::_p_instance{nullptr};
+SpiDispatcher * SpiDispatcher::_p_instance_list{nullptr};
 rtos::Mutex SpiDispatcher::_mutex;
 
 /**************************************************************************************
  * CTOR/DTOR
  **************************************************************************************/
 
-SpiDispatcher::SpiDispatcher()
-: _thread(osPriorityRealtime, 4096, nullptr, "SpiDispatcher")
+SpiDispatcher::SpiDispatcher(arduino::HardwareSPI & spi)
+: _spi{spi}
+, _p_next{nullptr}
+, _thread(osPriorityRealtime, 4096, nullptr, "SpiDispatcher")
 , _has_tread_started{false}
 , _terminate_thread{false}
+, _bus_calls{0}
 {
+  _queue_full_response.status = IoStatus::QueueFull;
+  _queue_full_response.done();
   begin();
 }
 
@@ -52,48 +60,95 @@ SpiDispatcher::~SpiDispatcher()
  * PUBLIC MEMBER FUNCTIONS
  **************************************************************************************/
 
-SpiDispatcher & SpiDispatcher::instance()
+SpiDispatcher & SpiDispatcher::instance(arduino::HardwareSPI & spi)
 {
   mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  if (!_p_instance) {
-    _p_instance = new SpiDispatcher();
+
+  SpiDispatcher * dispatcher = _p_instance_list;
+  while (dispatcher && (&dispatcher->_spi != &spi))
+    dispatcher = dispatcher->_p_next;
+
+  if (!dispatcher)
+  {
+    dispatcher = new SpiDispatcher(spi);
+    dispatcher->_p_next = _p_instance_list;
+    _p_instance_list = dispatcher;
   }
-  return *_p_instance;
+
+  return *dispatcher;
 }
 
 void SpiDispatcher::destroy()
 {
   mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  delete _p_instance;
-  _p_instance = nullptr;
+  while (_p_instance_list)
+  {
+    SpiDispatcher * dispatcher = _p_instance_list;
+    _p_instance_list = dispatcher->_p_next;
+    delete dispatcher;
+  }
 }
 
-IoResponse SpiDispatcher::dispatch(IoRequest * req, SpiBusDeviceConfig * config)
+IoResponse SpiDispatcher::dispatch(IoRequest * req, SpiBusDeviceConfig * config, IoCompletionCallback on_complete)
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  /* Both the response pool and the transaction queue are thread-safe,
+   * no global lock is required. This way requests to different busses
+   * do not contend with each other.
+   */
+  auto const deadline = queueDeadline(req);
 
-  SpiIoTransaction * spi_io_transaction = _spi_io_transaction_mailbox.try_alloc();
-  if (!spi_io_transaction)
-    return nullptr;
+  IoResponse rsp = _response_pool.alloc_until(on_complete, deadline);
+  if (!rsp || !enqueue(req, config, rsp, deadline))
+    return IoResponse::unmanaged(&_queue_full_response);
 
-  IoResponse rsp(new impl::IoResponse());
+  return rsp;
+}
 
-  spi_io_transaction->req = req;
-  spi_io_transaction->rsp = rsp;
-  spi_io_transaction->config = config;
+void SpiDispatcher::dispatchAndWait(IoRequest * req, SpiBusDeviceConfig * config, IoResult & result)
+{
+  /* The result is owned by the calling thread, which is registered as
+   * waiting thread before the dispatcher thread may complete it.
+   */
+  result.prepareWait();
 
-  _spi_io_transaction_mailbox.put(spi_io_transaction);
+  if (!enqueue(req, config, IoResponse::unmanaged(&result), queueDeadline(req)))
+  {
+    result.status = IoStatus::QueueFull;
+    result.done();
+  }
 
-  return rsp;
+  result.wait();
 }
 
 /**************************************************************************************
  * PRIVATE MEMBER FUNCTIONS
  **************************************************************************************/
 
+rtos::Kernel::Clock::time_point SpiDispatcher::queueDeadline(IoRequest const * req)
+{
+  if (req->queue_timeout == rtos::Kernel::wait_for_u32_forever)
+    return rtos::Kernel::Clock::time_point::max();
+  return rtos::Kernel::Clock::now() + req->queue_timeout;
+}
+
+bool SpiDispatcher::enqueue(IoRequest * req, SpiBusDeviceConfig * config, IoResponse const & rsp, rtos::Kernel::Clock::time_point const deadline)
+{
+  SpiIoTransaction * spi_io_transaction = _spi_io_transaction_queue.try_alloc_until(deadline);
+  if (!spi_io_transaction)
+    return false;
+
+  /* The queue provides raw memory, the transaction (which holds
+   * a reference to the response) is therefore constructed in place.
+   */
+  new (spi_io_transaction) SpiIoTransaction{req, rsp, config, rtos::Kernel::Clock::now()};
+
+  _spi_io_transaction_queue.put(spi_io_transaction, req->priority);
+  return true;
+}
+
 void SpiDispatcher::begin()
 {
-  SPI.begin();
+  _spi.begin();
   _thread.start(mbed::callback(this, &SpiDispatcher::threadFunc)); /* TODO: Check return code */
   /* It is necessary to wait until the SpiDispatcher::threadFunc()
    * has started, otherwise other threads might trigger IO requests
@@ -106,7 +161,7 @@ void SpiDispatcher::end()
 {
   _terminate_thread = true;
   _thread.join(); /* TODO: Check return code */
-  SPI.end();
+  _spi.end();
 }
 
 void SpiDispatcher::threadFunc()
@@ -115,61 +170,176 @@ void SpiDispatcher::threadFunc()
 
   while(!_terminate_thread)
   {
-    /* Wait blocking for the next IO transaction
-     * request to be posted to the mailbox.
+    SpiIoTransaction * spi_io_transaction = nextTransaction(true /* wait */);
+    SpiLink link_prev = SpiLink::None;
+
+    /* Process all requests queued back-to-back. The next request is
+     * taken from the queue (and checked against its deadline) once the
+     * current one has been transferred, but before it is completed.
+     * This allows to skip reconfiguring the bus (and deasserting the
+     * chip select) in between requests which do not require it while
+     * a request of higher priority arriving in the meantime is still
+     * started first. The configuration of a request must not be
+     * accessed once it is completed since the requesting thread may
+     * destroy it right away.
      */
-    SpiIoTransaction * spi_io_transaction = _spi_io_transaction_mailbox.try_get_for(rtos::Kernel::wait_for_u32_forever);
-    if (spi_io_transaction)
+    while (spi_io_transaction)
     {
-      processSpiIoRequest(spi_io_transaction);
-      /* Free the allocated memory (memory allocated
-       * during dispatch(...)
-       */
-      _spi_io_transaction_mailbox.free(spi_io_transaction);
+      processSpiIoRequest(spi_io_transaction, link_prev);
+
+      SpiIoTransaction * next_spi_io_transaction = nextTransaction(false /* wait */);
+      link_prev = link(spi_io_transaction->config, next_spi_io_transaction ? next_spi_io_transaction->config : nullptr);
+      unlink(spi_io_transaction->config, link_prev);
+
+      spi_io_transaction->rsp->done();
+      release(spi_io_transaction);
+      spi_io_transaction = next_spi_io_transaction;
     }
   }
 }
 
-void SpiDispatcher::processSpiIoRequest(SpiIoTransaction * spi_io_transaction)
+SpiDispatcher::SpiLink SpiDispatcher::link(SpiBusDeviceConfig * prev_config, SpiBusDeviceConfig * next_config)
+{
+  if (!prev_config || !next_config)
+    return SpiLink::None;
+
+  if ((&prev_config->spi() != &next_config->spi()) || (prev_config->settings() != next_config->settings()))
+    return SpiLink::None;
+
+  bool const is_same_device = (prev_config->csPin() >= 0) && (prev_config->csPin() == next_config->csPin());
+  if (is_same_device && prev_config->keepCsAsserted() && next_config->keepCsAsserted())
+    return SpiLink::KeepCsAsserted;
+
+  return SpiLink::SameSettings;
+}
+
+void SpiDispatcher::unlink(SpiBusDeviceConfig * config, SpiLink const link_next)
+{
+  if (link_next == SpiLink::None)
+  {
+    config->spi().endTransaction();
+    _bus_calls.store(_bus_calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  if (link_next != SpiLink::KeepCsAsserted)
+    config->deselect();
+}
+
+SpiDispatcher::SpiIoTransaction * SpiDispatcher::nextTransaction(bool const wait)
+{
+  for (;;)
+  {
+    /* Wait blocking for the next IO transaction
+     * request to be posted to the queue (if requested).
+     */
+    SpiIoTransaction * spi_io_transaction = wait ? _spi_io_transaction_queue.try_get_for(rtos::Kernel::wait_for_u32_forever)
+                                                  : _spi_io_transaction_queue.try_get();
+    if (!spi_io_transaction)
+      return nullptr;
+
+    auto const now = rtos::Kernel::Clock::now();
+    spi_io_transaction->rsp->queueing_delay = now - spi_io_transaction->submitted;
+
+    if (now <= spi_io_transaction->req->deadline)
+      return spi_io_transaction;
+
+    /* Discard requests which could not be started in time. */
+    spi_io_transaction->rsp->deadline_missed = true;
+    spi_io_transaction->rsp->status = IoStatus::DeadlineMissed;
+    spi_io_transaction->rsp->done();
+    release(spi_io_transaction);
+  }
+}
+
+void SpiDispatcher::release(SpiIoTransaction * spi_io_transaction)
+{
+  /* Release the reference to the response and free the
+   * allocated memory (memory allocated during dispatch(...)).
+   */
+  spi_io_transaction->~SpiIoTransaction();
+  _spi_io_transaction_queue.free(spi_io_transaction);
+}
+
+void SpiDispatcher::processSpiIoRequest(SpiIoTransaction * spi_io_transaction, SpiLink const link_prev)
 {
   IoRequest          * io_request  = spi_io_transaction->req;
   IoResponse           io_response = spi_io_transaction->rsp;
   SpiBusDeviceConfig * config      = spi_io_transaction->config;
 
-  config->select();
+  size_t bus_calls = 0;
 
-  config->spi().beginTransaction(config->settings());
+  if (link_prev != SpiLink::KeepCsAsserted)
+    config->select();
 
-  /* In a first step transmit the complete write buffer and
-   * write back the receive data directly into the write buffer
-   */
-  size_t bytes_sent = 0;
-  for(; bytes_sent < io_request->bytes_to_write; bytes_sent++)
+  if (link_prev == SpiLink::None)
   {
-    uint8_t const tx_byte = io_request->write_buf[bytes_sent];
-    uint8_t const rx_byte = config->spi().transfer(tx_byte);
-
-    io_request->write_buf[bytes_sent] = rx_byte;
+    config->spi().beginTransaction(config->settings());
+    bus_calls++;
   }
 
-  /* In a second step, transmit the fill symbol and write the
-   * received data into the read buffer.
+  /* A plain request consists of a (full-duplex) write phase
+   * followed by a read phase.
    */
-  size_t bytes_received = 0;
-  for(; bytes_received < io_request->bytes_to_read; bytes_received++)
+  IoSegment const plain_segments[2] =
   {
-    uint8_t const tx_byte = config->fillSymbol();
-    uint8_t const rx_byte = config->spi().transfer(tx_byte);
-
-    io_request->read_buf[bytes_received] = rx_byte;
+    IoSegment::duplex(io_request->write_buf, io_request->write_rx_buf, io_request->bytes_to_write),
+    IoSegment::rx    (io_request->read_buf, io_request->bytes_to_read)
+  };
+  IoSegment const * segments     = io_request->segments ? io_request->segments     : plain_segments;
+  size_t    const   num_segments = io_request->segments ? io_request->num_segments : 2;
+
+  size_t bytes_sent = 0, bytes_received = 0;
+  for (size_t s = 0; s < num_segments; s++)
+  {
+    bus_calls += transferSegment(config, segments[s]);
+    if (segments[s].tx_buf) bytes_sent += segments[s].len;
+    if (segments[s].rx_buf) bytes_received += segments[s].len;
   }
 
-  config->spi().endTransaction();
+  if (!io_request->segments)
+  {
+    bytes_sent = io_request->bytes_to_write;
+    bytes_received = io_request->bytes_to_read;
+  }
 
-  config->deselect();
+  _bus_calls.store(_bus_calls.load(std::memory_order_relaxed) + bus_calls, std::memory_order_relaxed);
 
   io_response->bytes_written = bytes_sent;
   io_response->bytes_read = bytes_received;
+}
+
+size_t SpiDispatcher::transferSegment(SpiBusDeviceConfig * config, IoSegment const & segment)
+{
+  if (segment.len == 0)
+    return 0;
 
-  io_response->done();
+  /* Receiving (with or without transmitting): the data to be sent
+   * is placed into the receive buffer, which is then transferred in
+   * place with a single call so that the HAL can transmit it at line
+   * rate (or via DMA).
+   */
+  if (segment.rx_buf)
+  {
+    if (!segment.tx_buf)
+      memset(segment.rx_buf, config->fillSymbol(), segment.len);
+    else if (segment.tx_buf != segment.rx_buf)
+      memcpy(segment.rx_buf, segment.tx_buf, segment.len);
+
+    config->spi().transfer(segment.rx_buf, segment.len);
+    return 1;
+  }
+
+  /* Transmitting only: the HAL always writes the received data back
+   * into the buffer, the transmit data is therefore staged in chunks
+   * via the scratch buffer in order to leave the caller's data intact.
+   */
+  size_t bus_calls = 0;
+  for (size_t offset = 0; offset < segment.len; offset += sizeof(_tx_scratch_buf))
+  {
+    size_t const chunk_len = std::min(segment.len - offset, sizeof(_tx_scratch_buf));
+    memcpy(_tx_scratch_buf, segment.tx_buf + offset, chunk_len);
+    config->spi().transfer(_tx_scratch_buf, chunk_len);
+    bus_calls++;
+  }
+  return bus_calls;
 }
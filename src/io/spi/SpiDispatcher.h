@@ -25,7 +25,10 @@
 
 #include <mbed.h>
 
+#include <atomic>
+
 #include "../IoTransaction.h"
+#include "../IoTransactionQueue.h"
 
 #include "SpiBusDeviceConfig.h"
 
@@ -40,37 +43,94 @@ public:
   SpiDispatcher(SpiDispatcher &) = delete;
   void operator = (SpiDispatcher &) = delete;
 
-  static SpiDispatcher & instance();
+  /* Every SPI bus is served by its own dispatcher (and thread), which
+   * is created the first time a request is dispatched to this bus.
+   */
+  static SpiDispatcher & instance(arduino::HardwareSPI & spi);
+  /* Terminates the dispatchers of all SPI busses. */
   static void destroy();
 
-  IoResponse dispatch(IoRequest * req, SpiBusDeviceConfig * config);
+  /* If either the request queue is full or all responses are still
+   * referenced (for longer than IoRequest::queue_timeout) the request
+   * is rejected: a completed response with IoStatus::QueueFull is
+   * returned and the completion callback is not invoked.
+   */
+  IoResponse dispatch(IoRequest * req, SpiBusDeviceConfig * config, IoCompletionCallback on_complete = nullptr);
+  /* Synchronous variant of dispatch(): no response is taken from the
+   * pool, the dispatcher reports directly into 'result' (usually on the
+   * stack of the calling thread) and the calling thread is resumed via
+   * its thread flags. Returns once the request has been processed.
+   */
+  void dispatchAndWait(IoRequest * req, SpiBusDeviceConfig * config, IoResult & result);
+
+  /* Number of calls into the SPI HAL (beginTransaction, transfer,
+   * endTransaction) performed by the dispatcher since its creation.
+   */
+  size_t busCalls() const { return _bus_calls.load(std::memory_order_relaxed); }
+  /* Number of responses taken from the response pool by dispatch(). */
+  size_t responseAllocations() { return _response_pool.allocations(); }
 
 private:
 
-  static SpiDispatcher * _p_instance;
+  static SpiDispatcher * _p_instance_list;
   static rtos::Mutex _mutex;
 
+  arduino::HardwareSPI & _spi;
+  SpiDispatcher * _p_next; /* Next dispatcher in _p_instance_list. */
   rtos::Thread _thread;
   bool _has_tread_started;
   bool _terminate_thread;
+  std::atomic<size_t> _bus_calls; /* Only written by the dispatcher thread. */
 
   typedef struct
   {
     IoRequest  * req;
     IoResponse rsp;
     SpiBusDeviceConfig * config;
+    rtos::Kernel::Clock::time_point submitted;
   } SpiIoTransaction;
 
   static size_t constexpr REQUEST_QUEUE_SIZE = 32;
-  rtos::Mail<SpiIoTransaction, REQUEST_QUEUE_SIZE> _spi_io_transaction_mailbox;
-
-   SpiDispatcher();
+  impl::IoTransactionQueue<SpiIoTransaction, REQUEST_QUEUE_SIZE> _spi_io_transaction_queue;
+  impl::IoResponsePool<REQUEST_QUEUE_SIZE> _response_pool;
+  /* Shared by all rejected requests, never returned to a pool. */
+  impl::IoResponse _queue_full_response;
+
+  /* Staging buffer for transmit-only segments, only
+   * accessed from within the dispatcher thread.
+   */
+  static size_t constexpr TX_SCRATCH_BUFFER_SIZE = 256;
+  byte _tx_scratch_buf[TX_SCRATCH_BUFFER_SIZE];
+
+   SpiDispatcher(arduino::HardwareSPI & spi);
   ~SpiDispatcher();
 
   void begin();
   void end();
+  static rtos::Kernel::Clock::time_point queueDeadline(IoRequest const * req);
+  bool enqueue(IoRequest * req, SpiBusDeviceConfig * config, IoResponse const & rsp, rtos::Kernel::Clock::time_point const deadline);
+  /* Describes how a transaction relates to the one processed right
+   * before (after) it, which determines the bus operations required
+   * in between them. Ordered from the weakest to the strongest link.
+   */
+  enum class SpiLink
+  {
+    None,           /* select, beginTransaction ... endTransaction, deselect */
+    SameSettings,   /* The bus settings are kept, only the chip select is toggled. */
+    KeepCsAsserted, /* Same device, the chip select remains asserted. */
+  };
+
   void threadFunc();
-  void processSpiIoRequest(SpiIoTransaction * spi_io_transaction);
+  SpiIoTransaction * nextTransaction(bool const wait);
+  void release(SpiIoTransaction * spi_io_transaction);
+  void processSpiIoRequest(SpiIoTransaction * spi_io_transaction, SpiLink const link_prev);
+  size_t transferSegment(SpiBusDeviceConfig * config, IoSegment const & segment);
+
+  static SpiLink link(SpiBusDeviceConfig * prev_config, SpiBusDeviceConfig * next_config);
+  /* Releases the bus after a transaction as far as required
+   * for the link 'link_next' to its successor.
+   */
+  void unlink(SpiBusDeviceConfig * config, SpiLink const link_next);
 };
 
 #endif /* SPI_DISPATCHER_H_ */
@@ -32,3 +32,9 @@ IoResponse transferAndWait(BusDevice & dev, IoRequest & req)
   rsp->wait();
   return rsp;
 }
+
+IoStatus transferAndWait(BusDevice & dev, IoRequest & req, IoResult & result)
+{
+  dev.transferAndWait(req, result);
+  return result.status;
+}
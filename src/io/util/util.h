@@ -31,5 +31,9 @@
  **************************************************************************************/
 
 IoResponse transferAndWait(BusDevice & dev, IoRequest & req);
+/* Synchronous transfer without taking a response from the pool of the
+ * dispatcher, the outcome is stored in 'result' (e.g. on the stack).
+ */
+IoStatus transferAndWait(BusDevice & dev, IoRequest & req, IoResult & result);
 
 #endif /* ARDUINO_THREADS_UTIL_H_ */
\ No newline at end of file
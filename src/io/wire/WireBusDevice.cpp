@@ -38,28 +38,38 @@ WireBusDevice::WireBusDevice(WireBusDeviceConfig const & config)
  * PUBLIC MEMBER FUNCTIONS
  **************************************************************************************/
 
-IoResponse WireBusDevice::transfer(IoRequest & req)
+IoResponse WireBusDevice::transfer(IoRequest & req, IoCompletionCallback on_complete)
 {
-  return WireDispatcher::instance().dispatch(&req, &_config);
+  return WireDispatcher::instance(_config.wire()).dispatch(&req, &_config, on_complete);
+}
+
+void WireBusDevice::transferAndWait(IoRequest & req, IoResult & result)
+{
+  WireDispatcher::instance(_config.wire()).dispatchAndWait(&req, &_config, result);
+}
+
+void WireBusDevice::setTimeout(rtos::Kernel::Clock::duration const timeout)
+{
+  _config.setTimeout(timeout);
 }
 
 bool WireBusDevice::read(uint8_t * buffer, size_t len, bool stop)
 {
-  WireBusDeviceConfig config(_config.wire(), _config.slaveAddr(), _config.restart(), stop);
+  WireBusDeviceConfig config(_config, _config.restart(), stop);
   IoRequest req(nullptr, 0, buffer, len);
-  IoResponse rsp = WireDispatcher::instance().dispatch(&req, &config);
-  rsp->wait();
-  return true;
+  IoResult result;
+  WireDispatcher::instance(_config.wire()).dispatchAndWait(&req, &config, result);
+  return (result.status == IoStatus::Ok);
 }
 
 bool WireBusDevice::write(uint8_t * buffer, size_t len, bool stop)
 {
   bool const restart = !stop;
-  WireBusDeviceConfig config(_config.wire(), _config.slaveAddr(), restart, _config.stop());
+  WireBusDeviceConfig config(_config, restart, _config.stop());
   IoRequest req(buffer, len, nullptr, 0);
-  IoResponse rsp = WireDispatcher::instance().dispatch(&req, &config);
-  rsp->wait();
-  return true;
+  IoResult result;
+  WireDispatcher::instance(_config.wire()).dispatchAndWait(&req, &config, result);
+  return (result.status == IoStatus::Ok);
 }
 
 bool WireBusDevice::writeThenRead(uint8_t * write_buffer, size_t write_len, uint8_t * read_buffer, size_t read_len, bool stop)
@@ -68,13 +78,10 @@ bool WireBusDevice::writeThenRead(uint8_t * write_buffer, size_t write_len, uint
    * which can be modified via the parameters of this function.
    */
   bool const restart = !stop;
-  WireBusDeviceConfig config(_config.wire(), _config.slaveAddr(), restart, _config.stop());
+  WireBusDeviceConfig config(_config, restart, _config.stop());
   /* Fire off the IO request and await its response. */
   IoRequest req(write_buffer, write_len, read_buffer, read_len);
-  IoResponse rsp = WireDispatcher::instance().dispatch(&req, &config);
-  rsp->wait();
-  /* TODO: Introduce error codes within the IoResponse and evaluate
-   * them here.
-   */
-  return true;
+  IoResult result;
+  WireDispatcher::instance(_config.wire()).dispatchAndWait(&req, &config, result);
+  return (result.status == IoStatus::Ok);
 }
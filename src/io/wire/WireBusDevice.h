@@ -39,9 +39,17 @@ public:
   virtual ~WireBusDevice() { }
 
 
-  virtual IoResponse transfer(IoRequest & req) override;
+  virtual IoResponse transfer(IoRequest & req, IoCompletionCallback on_complete = nullptr) override;
+  virtual void transferAndWait(IoRequest & req, IoResult & result) override;
 
+  /* Requests to a device not responding within the timeout
+   * are aborted with IoStatus::Timeout.
+   */
+  void setTimeout(rtos::Kernel::Clock::duration const timeout);
 
+  /* Return false if the request failed, transfer() provides the
+   * IoStatus and the number of bytes transferred.
+   */
   bool read(uint8_t * buffer, size_t len, bool stop = true);
   bool write(uint8_t * buffer, size_t len, bool stop = true);
   bool writeThenRead(uint8_t * write_buffer, size_t write_len, uint8_t * read_buffer, size_t read_len, bool stop = false);
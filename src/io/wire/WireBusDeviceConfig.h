@@ -24,6 +24,7 @@
  **************************************************************************************/
 
 #include <Arduino.h>
+#include <mbed.h>
 
 #include <Wire.h>
 
@@ -42,18 +43,30 @@ public:
   , _stop{stop}
   { }
 
+  WireBusDeviceConfig(WireBusDeviceConfig const & other, bool const restart, bool const stop)
+  : WireBusDeviceConfig{other}
+  {
+    _restart = restart;
+    _stop = stop;
+  }
+
 
   inline arduino::HardwareI2C & wire() { return _wire; }
   inline byte slaveAddr()  const { return _slave_addr; }
   inline bool restart()    const { return _restart; }
   inline bool stop()       const { return _stop; }
 
+  /* Maximum time to wait for the data requested from the device. */
+  inline rtos::Kernel::Clock::duration timeout() const { return _timeout; }
+  inline void setTimeout(rtos::Kernel::Clock::duration const timeout) { _timeout = timeout; }
+
 
 private:
 
   arduino::HardwareI2C & _wire;
   byte _slave_addr{0x00};
   bool _restart{true}, _stop{true};
+  rtos::Kernel::Clock::duration _timeout{std::chrono::milliseconds(100)};
 
 };
 
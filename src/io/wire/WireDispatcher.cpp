@@ -22,24 +22,30 @@
 
 #include "WireDispatcher.h"
 
+#include <new>
+
 #include <Wire.h>
 
 /**************************************************************************************
  * STATIC MEMBER DEFINITION
  **************************************************************************************/
 
-WireDispatcher * WireDispatcher::_p_instance{nullptr};
+WireDispatcher * WireDispatcher::_p_instance_list{nullptr};
 rtos::Mutex WireDispatcher::_mutex;
 
 /**************************************************************************************
  * CTOR/DTOR
  **************************************************************************************/
 
-WireDispatcher::WireDispatcher()
-: _thread(osPriorityRealtime, 4096, nullptr, "WireDispatcher")
+WireDispatcher::WireDispatcher(arduino::HardwareI2C & wire)
+: _wire{wire}
+, _p_next{nullptr}
+, _thread(osPriorityRealtime, 4096, nullptr, "WireDispatcher")
 , _has_tread_started{false}
 , _terminate_thread{false}
 {
+  _queue_full_response.status = IoStatus::QueueFull;
+  _queue_full_response.done();
   begin();
 }
 
@@ -52,48 +58,95 @@ WireDispatcher::~WireDispatcher()
  * PUBLIC MEMBER FUNCTIONS
  **************************************************************************************/
 
-WireDispatcher & WireDispatcher::instance()
+WireDispatcher & WireDispatcher::instance(arduino::HardwareI2C & wire)
 {
   mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  if (!_p_instance) {
-    _p_instance = new WireDispatcher();
+
+  WireDispatcher * dispatcher = _p_instance_list;
+  while (dispatcher && (&dispatcher->_wire != &wire))
+    dispatcher = dispatcher->_p_next;
+
+  if (!dispatcher)
+  {
+    dispatcher = new WireDispatcher(wire);
+    dispatcher->_p_next = _p_instance_list;
+    _p_instance_list = dispatcher;
   }
-  return *_p_instance;
+
+  return *dispatcher;
 }
 
 void WireDispatcher::destroy()
 {
   mbed::ScopedLock<rtos::Mutex> lock(_mutex);
-  delete _p_instance;
-  _p_instance = nullptr;
+  while (_p_instance_list)
+  {
+    WireDispatcher * dispatcher = _p_instance_list;
+    _p_instance_list = dispatcher->_p_next;
+    delete dispatcher;
+  }
 }
 
-IoResponse WireDispatcher::dispatch(IoRequest * req, WireBusDeviceConfig * config)
+IoResponse WireDispatcher::dispatch(IoRequest * req, WireBusDeviceConfig * config, IoCompletionCallback on_complete)
 {
-  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  /* Both the response pool and the transaction queue are thread-safe,
+   * no global lock is required. This way requests to different busses
+   * do not contend with each other.
+   */
+  auto const deadline = queueDeadline(req);
 
-  WireIoTransaction * wire_io_transaction = _wire_io_transaction_mailbox.try_alloc();
-  if (!wire_io_transaction)
-    return nullptr;
+  IoResponse rsp = _response_pool.alloc_until(on_complete, deadline);
+  if (!rsp || !enqueue(req, config, rsp, deadline))
+    return IoResponse::unmanaged(&_queue_full_response);
 
-  IoResponse rsp(new impl::IoResponse());
+  return rsp;
+}
 
-  wire_io_transaction->req = req;
-  wire_io_transaction->rsp = rsp;
-  wire_io_transaction->config = config;
+void WireDispatcher::dispatchAndWait(IoRequest * req, WireBusDeviceConfig * config, IoResult & result)
+{
+  /* The result is owned by the calling thread, which is registered as
+   * waiting thread before the dispatcher thread may complete it.
+   */
+  result.prepareWait();
 
-  _wire_io_transaction_mailbox.put(wire_io_transaction);
+  if (!enqueue(req, config, IoResponse::unmanaged(&result), queueDeadline(req)))
+  {
+    result.status = IoStatus::QueueFull;
+    result.done();
+  }
 
-  return rsp;
+  result.wait();
 }
 
 /**************************************************************************************
  * PRIVATE MEMBER FUNCTIONS
  **************************************************************************************/
 
+rtos::Kernel::Clock::time_point WireDispatcher::queueDeadline(IoRequest const * req)
+{
+  if (req->queue_timeout == rtos::Kernel::wait_for_u32_forever)
+    return rtos::Kernel::Clock::time_point::max();
+  return rtos::Kernel::Clock::now() + req->queue_timeout;
+}
+
+bool WireDispatcher::enqueue(IoRequest * req, WireBusDeviceConfig * config, IoResponse const & rsp, rtos::Kernel::Clock::time_point const deadline)
+{
+  WireIoTransaction * wire_io_transaction = _wire_io_transaction_queue.try_alloc_until(deadline);
+  if (!wire_io_transaction)
+    return false;
+
+  /* The queue provides raw memory, the transaction (which holds
+   * a reference to the response) is therefore constructed in place.
+   */
+  new (wire_io_transaction) WireIoTransaction{req, rsp, config, rtos::Kernel::Clock::now()};
+
+  _wire_io_transaction_queue.put(wire_io_transaction, req->priority);
+  return true;
+}
+
 void WireDispatcher::begin()
 {
-  Wire.begin();
+  _wire.begin();
   _thread.start(mbed::callback(this, &WireDispatcher::threadFunc)); /* TODO: Check return code */
   /* It is necessary to wait until the WireDispatcher::threadFunc()
    * has started, otherwise other threads might trigger IO requests
@@ -106,7 +159,7 @@ void WireDispatcher::end()
 {
   _terminate_thread = true;
   _thread.join(); /* TODO: Check return code */
-  Wire.end();
+  _wire.end();
 }
 
 void WireDispatcher::threadFunc()
@@ -115,60 +168,154 @@ void WireDispatcher::threadFunc()
 
   while(!_terminate_thread)
   {
-    /* Wait blocking for the next IO transaction
-     * request to be posted to the mailbox.
-     */
-    WireIoTransaction * wire_io_transaction = _wire_io_transaction_mailbox.try_get_for(rtos::Kernel::wait_for_u32_forever);
+    WireIoTransaction * wire_io_transaction = nextTransaction(true /* wait */);
     if (wire_io_transaction)
     {
       processWireIoRequest(wire_io_transaction);
-      /* Free the allocated memory (memory allocated
-       * during dispatch(...)
-       */
-      _wire_io_transaction_mailbox.free(wire_io_transaction);
+      release(wire_io_transaction);
     }
   }
 }
 
+WireDispatcher::WireIoTransaction * WireDispatcher::nextTransaction(bool const wait)
+{
+  for (;;)
+  {
+    /* Wait blocking for the next IO transaction
+     * request to be posted to the queue (if requested).
+     */
+    WireIoTransaction * wire_io_transaction = wait ? _wire_io_transaction_queue.try_get_for(rtos::Kernel::wait_for_u32_forever)
+                                                  : _wire_io_transaction_queue.try_get();
+    if (!wire_io_transaction)
+      return nullptr;
+
+    auto const now = rtos::Kernel::Clock::now();
+    wire_io_transaction->rsp->queueing_delay = now - wire_io_transaction->submitted;
+
+    if (now <= wire_io_transaction->req->deadline)
+      return wire_io_transaction;
+
+    /* Discard requests which could not be started in time. */
+    wire_io_transaction->rsp->deadline_missed = true;
+    wire_io_transaction->rsp->status = IoStatus::DeadlineMissed;
+    wire_io_transaction->rsp->done();
+    release(wire_io_transaction);
+  }
+}
+
+void WireDispatcher::release(WireIoTransaction * wire_io_transaction)
+{
+  /* Release the reference to the response and free the
+   * allocated memory (memory allocated during dispatch(...)).
+   */
+  wire_io_transaction->~WireIoTransaction();
+  _wire_io_transaction_queue.free(wire_io_transaction);
+}
+
 void WireDispatcher::processWireIoRequest(WireIoTransaction * wire_io_transaction)
 {
   IoRequest           * io_request  = wire_io_transaction->req;
   IoResponse            io_response = wire_io_transaction->rsp;
   WireBusDeviceConfig * config      = wire_io_transaction->config;
 
-  if (io_request->bytes_to_write > 0)
+  /* A plain request consists of a write phase followed by a read phase. */
+  IoSegment const plain_segments[2] =
+  {
+    IoSegment::tx(io_request->write_buf, io_request->bytes_to_write),
+    IoSegment::rx(io_request->read_buf, io_request->bytes_to_read)
+  };
+  IoSegment const * segments     = io_request->segments ? io_request->segments     : plain_segments;
+  size_t    const   num_segments = io_request->segments ? io_request->num_segments : 2;
+
+  /* Empty segments are skipped, the bus is only released (stop condition)
+   * after the last non-empty segment unless a repeated start is disabled.
+   */
+  size_t last_segment = num_segments;
+  for (size_t s = 0; s < num_segments; s++)
+    if (segments[s].len > 0)
+      last_segment = s;
+
+  for (size_t s = 0; (s < num_segments) && (io_response->status == IoStatus::Ok); s++)
   {
-    config->wire().beginTransmission(config->slaveAddr());
+    if (segments[s].len == 0)
+      continue;
 
-    size_t bytes_written = 0;
-    for (; bytes_written < io_request->bytes_to_write; bytes_written++)
+    bool const is_last_segment = (s == last_segment);
+
+    /* I2C is half-duplex, full-duplex segments are executed as a write. */
+    if (segments[s].tx_buf)
     {
-      config->wire().write(io_request->write_buf[bytes_written]);
+      io_response->status = transmitSegment(config, segments[s], is_last_segment || !config->restart());
+      if (io_response->status == IoStatus::Ok)
+        io_response->bytes_written += segments[s].len;
     }
-    io_response->bytes_written = bytes_written;
-
-    if (config->restart() && (io_request->bytes_to_read > 0))
-      config->wire().endTransmission(false /* stop */);
     else
-      config->wire().endTransmission(true /* stop */);
+    {
+      size_t bytes_read = 0;
+      io_response->status = receiveSegment(config, segments[s], is_last_segment ? config->stop() : !config->restart(), bytes_read);
+      io_response->bytes_read += bytes_read;
+    }
   }
 
-  if (io_request->bytes_to_read > 0)
+  io_response->done();
+}
+
+IoStatus WireDispatcher::transmitSegment(WireBusDeviceConfig * config, IoSegment const & segment, bool const stop)
+{
+  config->wire().beginTransmission(config->slaveAddr());
+
+  for (size_t bytes_written = 0; bytes_written < segment.len; bytes_written++)
   {
-    config->wire().requestFrom(config->slaveAddr(), io_request->bytes_to_read, config->stop());
+    config->wire().write(segment.tx_buf[bytes_written]);
+  }
 
-    while(config->wire().available() != static_cast<int>(io_request->bytes_to_read))
-    {
-      /* TODO: Insert a timeout. */
-    }
+  /* 0: success, 1: data too long, 2: NAK on address, 3: NAK on
+   * data, 4: other error (i.e. lost arbitration), 5: timeout.
+   */
+  switch (config->wire().endTransmission(stop))
+  {
+  case 0:  return IoStatus::Ok;
+  case 2:
+  case 3:  return IoStatus::Nak;
+  case 4:  return IoStatus::ArbitrationLost;
+  case 5:  return IoStatus::Timeout;
+  default: return IoStatus::Error;
+  }
+}
+
+IoStatus WireDispatcher::receiveSegment(WireBusDeviceConfig * config, IoSegment const & segment, bool const stop, size_t & bytes_read)
+{
+  /* requestFrom() returns the number of bytes received from
+   * the device, less than requested if it did not acknowledge.
+   */
+  size_t const bytes_requested = config->wire().requestFrom(config->slaveAddr(), segment.len, stop);
+  if (bytes_requested < segment.len)
+  {
+    /* Discard the bytes of an incomplete transfer. */
+    while (config->wire().available() > 0)
+      config->wire().read();
+    return IoStatus::Nak;
+  }
 
-    size_t bytes_read = 0;
-    for (; bytes_read < io_request->bytes_to_read; bytes_read++)
+  /* Drivers which complete requestFrom() before the data has been
+   * received are waited for without spinning on the bus driver,
+   * at most until the timeout of the device expires.
+   */
+  if (config->wire().available() < static_cast<int>(segment.len))
+  {
+    auto const deadline = rtos::Kernel::Clock::now() + config->timeout();
+    while (config->wire().available() < static_cast<int>(segment.len))
     {
-      io_request->read_buf[bytes_read] = config->wire().read();
+      if (rtos::Kernel::Clock::now() >= deadline)
+        return IoStatus::Timeout;
+      rtos::ThisThread::sleep_for(rtos::Kernel::Clock::duration_u32{1});
     }
-    io_response->bytes_read = bytes_read;
   }
 
-  io_response->done();
+  for (; bytes_read < segment.len; bytes_read++)
+  {
+    segment.rx_buf[bytes_read] = config->wire().read();
+  }
+
+  return IoStatus::Ok;
 }
@@ -26,6 +26,7 @@
 #include <mbed.h>
 
 #include "../IoTransaction.h"
+#include "../IoTransactionQueue.h"
 
 #include "WireBusDeviceConfig.h"
 
@@ -40,18 +41,35 @@ public:
   WireDispatcher(WireDispatcher &) = delete;
   void operator = (WireDispatcher &) = delete;
 
-  static WireDispatcher & instance();
+  /* Every I2C bus is served by its own dispatcher (and thread), which
+   * is created the first time a request is dispatched to this bus.
+   */
+  static WireDispatcher & instance(arduino::HardwareI2C & wire);
+  /* Terminates the dispatchers of all I2C busses. */
   static void destroy();
 
 
-  IoResponse dispatch(IoRequest * req, WireBusDeviceConfig * config);
+  /* If either the request queue is full or all responses are still
+   * referenced (for longer than IoRequest::queue_timeout) the request
+   * is rejected: a completed response with IoStatus::QueueFull is
+   * returned and the completion callback is not invoked.
+   */
+  IoResponse dispatch(IoRequest * req, WireBusDeviceConfig * config, IoCompletionCallback on_complete = nullptr);
+  /* Synchronous variant of dispatch(): no response is taken from the
+   * pool, the dispatcher reports directly into 'result' (usually on the
+   * stack of the calling thread) and the calling thread is resumed via
+   * its thread flags. Returns once the request has been processed.
+   */
+  void dispatchAndWait(IoRequest * req, WireBusDeviceConfig * config, IoResult & result);
 
 
 private:
 
-  static WireDispatcher * _p_instance;
+  static WireDispatcher * _p_instance_list;
   static rtos::Mutex _mutex;
 
+  arduino::HardwareI2C & _wire;
+  WireDispatcher * _p_next; /* Next dispatcher in _p_instance_list. */
   rtos::Thread _thread;
   bool _has_tread_started;
   bool _terminate_thread;
@@ -61,18 +79,28 @@ private:
     IoRequest  * req;
     IoResponse rsp;
     WireBusDeviceConfig * config;
+    rtos::Kernel::Clock::time_point submitted;
   } WireIoTransaction;
 
   static size_t constexpr REQUEST_QUEUE_SIZE = 32;
-  rtos::Mail<WireIoTransaction, REQUEST_QUEUE_SIZE> _wire_io_transaction_mailbox;
+  impl::IoTransactionQueue<WireIoTransaction, REQUEST_QUEUE_SIZE> _wire_io_transaction_queue;
+  impl::IoResponsePool<REQUEST_QUEUE_SIZE> _response_pool;
+  /* Shared by all rejected requests, never returned to a pool. */
+  impl::IoResponse _queue_full_response;
 
-   WireDispatcher();
+   WireDispatcher(arduino::HardwareI2C & wire);
   ~WireDispatcher();
 
   void begin();
   void end();
+  static rtos::Kernel::Clock::time_point queueDeadline(IoRequest const * req);
+  bool enqueue(IoRequest * req, WireBusDeviceConfig * config, IoResponse const & rsp, rtos::Kernel::Clock::time_point const deadline);
   void threadFunc();
+  WireIoTransaction * nextTransaction(bool const wait);
+  void release(WireIoTransaction * wire_io_transaction);
   void processWireIoRequest(WireIoTransaction * wire_io_transaction);
+  IoStatus transmitSegment(WireBusDeviceConfig * config, IoSegment const & segment, bool const stop);
+  IoStatus receiveSegment(WireBusDeviceConfig * config, IoSegment const & segment, bool const stop, size_t & bytes_read);
 };
 
 #endif /* WIRE_DISPATCHER_H_ */
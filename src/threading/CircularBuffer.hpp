@@ -23,28 +23,92 @@
  * INCLUDE
  **************************************************************************************/
 
-#include <SharedPtr.h>
+#include <stddef.h>
+
+#include <utility>
+#include <algorithm>
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+constexpr bool isPowerOfTwo(size_t const n)
+{
+  return (n > 0) && ((n & (n - 1)) == 0);
+}
+
+constexpr size_t nextPowerOfTwo(size_t const n)
+{
+  size_t p = 1;
+  while (p < n)
+    p <<= 1;
+  return p;
+}
 
 /**************************************************************************************
  * CLASS DECLARATION
  **************************************************************************************/
 
-template <typename T>
+/* CircularBuffer<T, SIZE> stores its SIZE elements inline, SIZE must
+ * be a power of two so that wrapping around is a simple bit mask.
+ * CircularBuffer<T> (SIZE = 0) allocates storage for a number of
+ * elements specified at runtime from the heap.
+ */
+template <typename T, size_t SIZE = 0>
 class CircularBuffer
 {
+public:
+
+  static_assert(isPowerOfTwo(SIZE), "CircularBuffer: SIZE must be a power of two");
+
+  CircularBuffer();
+
+  void store(T const & data);
+  T read();
+  size_t store(T const * data, size_t const num);
+  size_t read(T * data, size_t const num);
+  bool isFull() const;
+  bool isEmpty() const;
+  size_t size() const { return _num_elems; }
+  size_t capacity() const { return SIZE; }
+  T & newest() { return _data[(_head - 1) & MASK]; }
+
+
+private:
+
+  static size_t constexpr MASK = SIZE - 1;
+
+  T _data[SIZE];
+  size_t _head, _tail, _num_elems;
+
+  static size_t next(size_t const idx) { return ((idx + 1) & MASK); }
+};
+
+template <typename T>
+class CircularBuffer<T, 0>
+{
 public:
 
   CircularBuffer(size_t const size);
+  ~CircularBuffer();
+
+  CircularBuffer(CircularBuffer const &) = delete;
+  CircularBuffer & operator = (CircularBuffer const &) = delete;
 
-  void store(T const data);
+  void store(T const & data);
   T read();
+  size_t store(T const * data, size_t const num);
+  size_t read(T * data, size_t const num);
   bool isFull() const;
   bool isEmpty() const;
+  size_t size() const { return _num_elems; }
+  size_t capacity() const { return _size; }
+  T & newest() { return _data[(_head + _size - 1) % _size]; }
 
 
 private:
 
-  mbed::SharedPtr<T> _data;
+  T * _data;
   size_t const _size;
   size_t _head, _tail, _num_elems;
 
@@ -52,11 +116,91 @@ private:
 };
 
 /**************************************************************************************
- * CTOR/DTOR
+ * CTOR/DTOR - CircularBuffer<T, SIZE>
+ **************************************************************************************/
+
+template <typename T, size_t SIZE>
+CircularBuffer<T, SIZE>::CircularBuffer()
+: _data{}
+, _head{0}
+, _tail{0}
+, _num_elems{0}
+{
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS - CircularBuffer<T, SIZE>
+ **************************************************************************************/
+
+template <typename T, size_t SIZE>
+void CircularBuffer<T, SIZE>::store(T const & data)
+{
+  if (!isFull())
+  {
+    _data[_head] = data;
+    _head = next(_head);
+    _num_elems++;
+  }
+}
+
+template <typename T, size_t SIZE>
+T CircularBuffer<T, SIZE>::read()
+{
+  if (isEmpty())
+    return T{};
+
+  T value = std::move(_data[_tail]);
+  _tail = next(_tail);
+  _num_elems--;
+
+  return value;
+}
+
+template <typename T, size_t SIZE>
+size_t CircularBuffer<T, SIZE>::store(T const * data, size_t const num)
+{
+  size_t const num_to_store = std::min(num, SIZE - _num_elems);
+  /* Copy in at most two contiguous segments: up to the end of
+   * the storage and then, after wrapping around, from its start.
+   */
+  size_t const num_first = std::min(num_to_store, SIZE - _head);
+  std::copy(data, data + num_first, _data + _head);
+  std::copy(data + num_first, data + num_to_store, _data);
+  _head = (_head + num_to_store) & MASK;
+  _num_elems += num_to_store;
+  return num_to_store;
+}
+
+template <typename T, size_t SIZE>
+size_t CircularBuffer<T, SIZE>::read(T * data, size_t const num)
+{
+  size_t const num_to_read = std::min(num, _num_elems);
+  size_t const num_first = std::min(num_to_read, SIZE - _tail);
+  std::move(_data + _tail, _data + _tail + num_first, data);
+  std::move(_data, _data + (num_to_read - num_first), data + num_first);
+  _tail = (_tail + num_to_read) & MASK;
+  _num_elems -= num_to_read;
+  return num_to_read;
+}
+
+template <typename T, size_t SIZE>
+bool CircularBuffer<T, SIZE>::isFull() const
+{
+  return (_num_elems == SIZE);
+}
+
+template <typename T, size_t SIZE>
+bool CircularBuffer<T, SIZE>::isEmpty() const
+{
+  return (_num_elems == 0);
+}
+
+/**************************************************************************************
+ * CTOR/DTOR - CircularBuffer<T>
  **************************************************************************************/
 
 template <typename T>
-CircularBuffer<T>::CircularBuffer(size_t const size)
+CircularBuffer<T, 0>::CircularBuffer(size_t const size)
 : _data{new T[size]}
 , _size{size}
 , _head{0}
@@ -65,28 +209,34 @@ CircularBuffer<T>::CircularBuffer(size_t const size)
 {
 }
 
+template <typename T>
+CircularBuffer<T, 0>::~CircularBuffer()
+{
+  delete[] _data;
+}
+
 /**************************************************************************************
- * PUBLIC MEMBER FUNCTIONS
+ * PUBLIC MEMBER FUNCTIONS - CircularBuffer<T>
  **************************************************************************************/
 
 template <typename T>
-void CircularBuffer<T>::store(T const data)
+void CircularBuffer<T, 0>::store(T const & data)
 {
   if (!isFull())
   {
-    _data.get()[_head] = data;
+    _data[_head] = data;
     _head = next(_head);
     _num_elems++;
   }
 }
 
 template <typename T>
-T CircularBuffer<T>::read()
+T CircularBuffer<T, 0>::read()
 {
   if (isEmpty())
-    return T{0};
+    return T{};
 
-  T const value = _data.get()[_tail];
+  T value = std::move(_data[_tail]);
   _tail = next(_tail);
   _num_elems--;
 
@@ -94,23 +244,47 @@ T CircularBuffer<T>::read()
 }
 
 template <typename T>
-bool CircularBuffer<T>::isFull() const
+size_t CircularBuffer<T, 0>::store(T const * data, size_t const num)
+{
+  size_t const num_to_store = std::min(num, _size - _num_elems);
+  size_t const num_first = std::min(num_to_store, _size - _head);
+  std::copy(data, data + num_first, _data + _head);
+  std::copy(data + num_first, data + num_to_store, _data);
+  _head = (_head + num_to_store) % _size;
+  _num_elems += num_to_store;
+  return num_to_store;
+}
+
+template <typename T>
+size_t CircularBuffer<T, 0>::read(T * data, size_t const num)
+{
+  size_t const num_to_read = std::min(num, _num_elems);
+  size_t const num_first = std::min(num_to_read, _size - _tail);
+  std::move(_data + _tail, _data + _tail + num_first, data);
+  std::move(_data, _data + (num_to_read - num_first), data + num_first);
+  _tail = (_tail + num_to_read) % _size;
+  _num_elems -= num_to_read;
+  return num_to_read;
+}
+
+template <typename T>
+bool CircularBuffer<T, 0>::isFull() const
 {
   return (_num_elems == _size);
 }
 
 template <typename T>
-bool CircularBuffer<T>::isEmpty() const
+bool CircularBuffer<T, 0>::isEmpty() const
 {
   return (_num_elems == 0);
 }
 
 /**************************************************************************************
- * PRIVATE MEMBER FUNCTIONS
+ * PRIVATE MEMBER FUNCTIONS - CircularBuffer<T>
  **************************************************************************************/
 
 template <typename T>
-size_t CircularBuffer<T>::next(size_t const idx)
+size_t CircularBuffer<T, 0>::next(size_t const idx)
 {
   return ((idx + 1) % _size);
 }
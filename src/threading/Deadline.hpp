@@ -0,0 +1,58 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_DEADLINE_HPP_
+#define ARDUINO_THREADS_DEADLINE_HPP_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <mbed.h>
+
+#include <chrono>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace impl
+{
+
+/**************************************************************************************
+ * FUNCTION DEFINITION
+ **************************************************************************************/
+
+/* Returns the time left until 'deadline', rounded up to a whole
+ * duration_u32 tick. Truncating instead would turn a remainder of
+ * less than one tick into a wait of 0, and the caller would spin
+ * until the deadline has passed.
+ */
+inline rtos::Kernel::Clock::duration_u32 remainingUntil(rtos::Kernel::Clock::time_point const deadline,
+                                                        rtos::Kernel::Clock::time_point const now)
+{
+  auto const remaining = deadline - now;
+  auto remaining_u32 = std::chrono::duration_cast<rtos::Kernel::Clock::duration_u32>(remaining);
+  if (remaining_u32 < remaining)
+    remaining_u32 += rtos::Kernel::Clock::duration_u32(1);
+  return remaining_u32;
+}
+
+} /* namespace impl */
+
+#endif /* ARDUINO_THREADS_DEADLINE_HPP_ */
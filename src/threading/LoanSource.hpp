@@ -0,0 +1,103 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_LOAN_SOURCE_HPP_
+#define ARDUINO_THREADS_LOAN_SOURCE_HPP_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include "Slot.hpp"
+#include "Source.hpp"
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* A Loan grants write access to a slot obtained via LoanSource::loan().
+ * publish() hands the slot to all connected sinks without copying the value,
+ * afterwards the loan is empty and must not be published again. A loan
+ * which is never published returns its slot to the pool upon destruction.
+ */
+template<typename T, size_t MAX_SINKS = SOURCE_MAX_SINKS>
+class Loan
+{
+public:
+
+  Loan(Slot<T> && slot, Source<Slot<T>, MAX_SINKS> & source) : _slot(std::move(slot)), _source(&source) { }
+  Loan(Loan && other) = default;
+
+  Loan(Loan const &) = delete;
+  Loan & operator = (Loan const &) = delete;
+
+  inline T & operator *  () { return _slot._entry->value; }
+  inline T * operator -> () { return &_slot._entry->value; }
+
+  void publish();
+
+
+private:
+
+  Slot<T> _slot;
+  Source<Slot<T>, MAX_SINKS> * _source;
+};
+
+/* LoanSource<T, POOL_SIZE> is connected to sinks of type Slot<T>. Each
+ * published value occupies one of POOL_SIZE slots until the last sink
+ * (and consumer) has released it, loan() suspends the calling thread
+ * while all slots are in use.
+ */
+template<typename T, size_t POOL_SIZE, size_t MAX_SINKS = SOURCE_MAX_SINKS>
+class LoanSource : public Source<Slot<T>, MAX_SINKS>
+{
+public:
+
+  Loan<T, MAX_SINKS> loan();
+
+
+private:
+
+  SlotPool<T, POOL_SIZE> _pool;
+};
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+template<typename T, size_t MAX_SINKS>
+void Loan<T,MAX_SINKS>::publish()
+{
+  /* A loan can be published only once, publishing an empty loan
+   * (already published or moved-from) would push an empty slot.
+   */
+  MBED_ASSERT(_slot);
+  if (!_slot)
+    return;
+
+  _source->push(_slot);
+  _slot = Slot<T>();
+}
+
+template<typename T, size_t POOL_SIZE, size_t MAX_SINKS>
+Loan<T, MAX_SINKS> LoanSource<T,POOL_SIZE,MAX_SINKS>::loan()
+{
+  return Loan<T, MAX_SINKS>(_pool.alloc(), *this);
+}
+
+#endif /* ARDUINO_THREADS_LOAN_SOURCE_HPP_ */
@@ -42,11 +42,12 @@ public:
 
   T pop();
   void push(T const & val);
-  inline T peek() const { return _val; }
+  T peek() const;
 
 private:
 
   T _val;
+  mutable rtos::Mutex _val_mutex;
   rtos::Mail<T, QUEUE_SIZE> _mailbox;
 
 };
@@ -65,30 +66,44 @@ T Shared<T,QUEUE_SIZE>::pop()
     _mailbox.free(val_ptr);
     return tmp_val;
   }
-  return _val;
+  return peek();
 }
 
 template<class T, size_t QUEUE_SIZE>
 void Shared<T,QUEUE_SIZE>::push(T const & val)
 {
+  _val_mutex.lock();
+  _val = val;
+  _val_mutex.unlock();
+
   /* If the mailbox is full we are discarding the
    * oldest element and then push the new one into
-   * the queue.
+   * the queue. The oldest element is removed without
+   * waiting as a consumer may have emptied the queue
+   * in the meantime.
    **/
-  if (_mailbox.full())
+  T * val_ptr = nullptr;
+  while ((val_ptr = _mailbox.try_alloc()) == nullptr)
   {
-    T * val_ptr = _mailbox.try_get_for(rtos::Kernel::wait_for_u32_forever);
-    _mailbox.free(val_ptr);
+    T * oldest_val_ptr = _mailbox.try_get();
+    if (oldest_val_ptr)
+      _mailbox.free(oldest_val_ptr);
+    else
+      /* All elements are held by concurrent pushers or poppers,
+       * let them (even if of lower priority) complete.
+       */
+      rtos::ThisThread::sleep_for(rtos::Kernel::Clock::duration_u32{1});
   }
 
-  _val = val;
+  *val_ptr = val;
+  _mailbox.put(val_ptr);
+}
 
-  T * val_ptr = _mailbox.try_alloc();
-  if (val_ptr)
-  {
-    *val_ptr = val;
-    _mailbox.put(val_ptr);
-  }
+template<class T, size_t QUEUE_SIZE>
+T Shared<T,QUEUE_SIZE>::peek() const
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_val_mutex);
+  return _val;
 }
 
 #endif /* ARDUINO_THREADS_SHARED_HPP_ */
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_SHARED_BROADCAST_HPP_
+#define ARDUINO_THREADS_SHARED_BROADCAST_HPP_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <mbed.h>
+
+#include "Shared.hpp"
+#include "CircularBuffer.hpp"
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* SharedBroadcast<T, QUEUE_SIZE> delivers every pushed value to every
+ * reader. All values are stored once within a single ring buffer, each
+ * reader only keeps its own read position (cursor). Pushing never waits
+ * for readers: a reader which falls more than QUEUE_SIZE values behind
+ * loses the oldest values, just as Shared<T> discards them.
+ */
+template<class T, size_t QUEUE_SIZE = SHARED_QUEUE_SIZE>
+class SharedBroadcast
+{
+public:
+
+  /* The cursors run freely and wrap at 2^32, masking them only yields
+   * consistent indices across that wrap if QUEUE_SIZE is a power of two.
+   */
+  static_assert(isPowerOfTwo(QUEUE_SIZE), "SharedBroadcast: QUEUE_SIZE must be a power of two");
+
+  class Reader
+  {
+  public:
+
+    /* The constructor does not access the shared variable, so that
+     * a reader can be declared at file scope in any translation unit.
+     * A reader receives all values pushed since startup which have
+     * not yet been overwritten.
+     */
+    Reader(SharedBroadcast & shared) : _shared(shared), _cursor(0), _num_lost(0) { }
+
+    inline T pop() { return _shared.pop(_cursor, _num_lost); }
+    inline bool available() const { return _shared.available(_cursor); }
+    /* Number of values overwritten before this reader could read them. */
+    inline uint32_t lost() const { return _num_lost; }
+
+  private:
+
+    SharedBroadcast & _shared;
+    uint32_t _cursor;
+    uint32_t _num_lost;
+  };
+
+
+  SharedBroadcast();
+
+  SharedBroadcast(SharedBroadcast const &) = delete;
+  SharedBroadcast & operator = (SharedBroadcast const &) = delete;
+
+  void push(T const & val);
+
+
+private:
+
+  static uint32_t constexpr MASK = QUEUE_SIZE - 1;
+
+  T _data[QUEUE_SIZE];
+  uint32_t _head;
+  mutable rtos::Mutex _mutex;
+  rtos::ConditionVariable _cond_data_available;
+
+  T pop(uint32_t & cursor, uint32_t & num_lost);
+  bool available(uint32_t const cursor) const;
+};
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+template<class T, size_t QUEUE_SIZE>
+SharedBroadcast<T,QUEUE_SIZE>::SharedBroadcast()
+: _data{}
+, _head(0)
+, _cond_data_available(_mutex)
+{ }
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+template<class T, size_t QUEUE_SIZE>
+void SharedBroadcast<T,QUEUE_SIZE>::push(T const & val)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  _data[_head & MASK] = val;
+  _head++;
+  _cond_data_available.notify_all();
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+template<class T, size_t QUEUE_SIZE>
+T SharedBroadcast<T,QUEUE_SIZE>::pop(uint32_t & cursor, uint32_t & num_lost)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  while (cursor == _head)
+    _cond_data_available.wait();
+
+  /* Skip all values which have already been overwritten. */
+  if ((_head - cursor) > QUEUE_SIZE)
+  {
+    num_lost += (_head - cursor) - QUEUE_SIZE;
+    cursor = _head - QUEUE_SIZE;
+  }
+
+  T const val = _data[cursor & MASK];
+  cursor++;
+  return val;
+}
+
+template<class T, size_t QUEUE_SIZE>
+bool SharedBroadcast<T,QUEUE_SIZE>::available(uint32_t const cursor) const
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  return (cursor != _head);
+}
+
+#endif /* ARDUINO_THREADS_SHARED_BROADCAST_HPP_ */
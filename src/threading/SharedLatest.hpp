@@ -0,0 +1,102 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_SHARED_LATEST_HPP_
+#define ARDUINO_THREADS_SHARED_LATEST_HPP_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <mbed.h>
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* SharedLatest<T> only stores the most recently pushed value. It is
+ * protected by a sequence lock: a writer increments the sequence
+ * counter before and after updating the value, a reader retries if
+ * the counter was odd or has changed while it was copying the value.
+ * Writers update the value within a (short) critical section and
+ * never wait for readers, readers never block at all.
+ */
+template<class T>
+class SharedLatest
+{
+public:
+
+  static_assert(std::is_trivially_copyable<T>::value, "SharedLatest: T must be trivially copyable");
+
+  SharedLatest() : _sequence{0}, _val{} { }
+
+  T pop() const { return peek(); }
+  void push(T const & val);
+  T peek() const { uint32_t sequence; return peek(sequence); }
+  /* Also returns the sequence number of the value, it
+   * changes (only) whenever a new value is pushed.
+   */
+  T peek(uint32_t & sequence) const;
+
+private:
+
+  std::atomic<uint32_t> _sequence;
+  T _val;
+
+};
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+template<class T>
+void SharedLatest<T>::push(T const & val)
+{
+  /* Serializes concurrent writers, on the targets
+   * this also prevents a writer from being preempted.
+   */
+  core_util_critical_section_enter();
+  uint32_t const sequence = _sequence.load(std::memory_order_relaxed);
+  _sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  memcpy(static_cast<void *>(&_val), &val, sizeof(T));
+  _sequence.store(sequence + 2, std::memory_order_release);
+  core_util_critical_section_exit();
+}
+
+template<class T>
+T SharedLatest<T>::peek(uint32_t & sequence) const
+{
+  T val;
+  uint32_t sequence_before, sequence_after;
+  do
+  {
+    sequence_before = _sequence.load(std::memory_order_acquire);
+    memcpy(&val, &_val, sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire);
+    sequence_after = _sequence.load(std::memory_order_relaxed);
+  } while ((sequence_before & 1) || (sequence_before != sequence_after));
+  sequence = sequence_after;
+  return val;
+}
+
+#endif /* ARDUINO_THREADS_SHARED_LATEST_HPP_ */
@@ -25,7 +25,39 @@
 
 #include <mbed.h>
 
+#include <atomic>
+
+#include "Deadline.hpp"
 #include "CircularBuffer.hpp"
+#include "SharedLatest.hpp"
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+#ifndef ARDUINO_THREADS_CACHE_LINE_SIZE
+/* Size of a Cortex-M7 L1 data cache line. */
+# define ARDUINO_THREADS_CACHE_LINE_SIZE 32
+#endif
+
+/* Thread flag used by SinkSpsc to resume a producer (consumer)
+ * thread which has been suspended on a full (empty) sink. Do not
+ * use this flag for events sent via Arduino_Threads::sendEvent().
+ */
+static uint32_t constexpr SINK_SPSC_THREAD_FLAG = (1UL << 30);
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+/* Determines what a SinkBlocking does with a value injected while it is full. */
+enum class SinkOverflowPolicy
+{
+  Block,      /* Suspend the producer until a slot becomes available. */
+  DropNewest, /* Discard the injected value. */
+  DropOldest, /* Discard the oldest queued value to make room. */
+  Overwrite,  /* Replace the most recently queued value. */
+};
 
 /**************************************************************************************
  * CLASS DECLARATION
@@ -40,46 +72,147 @@ public:
 
   virtual T pop() = 0;
   virtual void inject(T const & value) = 0;
+
+  /* Inject 'num' values at once, returns after all values have been
+   * injected. Buffering sinks override this in order to transfer the
+   * values under a single lock and with a single consumer notification.
+   */
+  virtual void inject(T const * values, size_t const num)
+  {
+    for (size_t i = 0; i < num; i++)
+      inject(values[i]);
+  }
+
+  /* Retrieve up to 'max' values at once, waiting no longer than 'timeout'
+   * for the first value to become available. Returns the number of values
+   * written to 'values'. Sinks without a buffer return a single value.
+   */
+  virtual size_t pop(T * values, size_t const max, rtos::Kernel::Clock::duration_u32 const /* timeout */ = rtos::Kernel::wait_for_u32_forever)
+  {
+    if (max == 0)
+      return 0;
+    values[0] = pop();
+    return 1;
+  }
+
+  /* Inject a value, waiting no longer than 'timeout' for a slot to become
+   * available. Returns false if the value has not been stored.
+   */
+  virtual bool inject_for(T const & value, rtos::Kernel::Clock::duration_u32 const /* timeout */)
+  {
+    inject(value);
+    return true;
+  }
+
+  inline bool pop_for(T & value, rtos::Kernel::Clock::duration_u32 const timeout) { return (pop(&value, 1, timeout) == 1); }
+  inline bool try_pop(T & value) { return pop_for(value, rtos::Kernel::Clock::duration_u32{0}); }
 };
 
+/* SinkNonBlocking<T> only holds the latest injected value within a
+ * sequence locked cell (see SharedLatest<T>): injecting overwrites the
+ * value and reading never waits, takes a lock or calls into the kernel.
+ */
 template<typename T>
 class SinkNonBlocking : public SinkBase<T>
 {
 public:
 
-           SinkNonBlocking() { }
+           SinkNonBlocking() : _last_sequence(0) { }
   virtual ~SinkNonBlocking() { }
 
+  using SinkBase<T>::inject;
+
   virtual T pop() override;
   virtual void inject(T const & value) override;
+  /* Never waits, returns 1 only if a new value has been injected since the last pop. */
+  virtual size_t pop(T * values, size_t const max, rtos::Kernel::Clock::duration_u32 const timeout = rtos::Kernel::wait_for_u32_forever) override;
+
+  /* Returns true if the value has been injected since the last pop. */
+  bool pop(T & value);
 
 
 private:
 
-  T _data;
-  rtos::Mutex _mutex;
+  SharedLatest<T> _data;
+  uint32_t _last_sequence;
 
 };
 
-template<typename T>
+/* SinkBlocking<T, SIZE> buffers up to SIZE elements without any
+ * heap allocation, its storage is rounded up to the next power of two.
+ * SinkBlocking<T> (SIZE = 0) allocates a buffer of the size passed to
+ * its constructor from the heap. POLICY determines how values injected
+ * into a full sink are handled.
+ */
+template<typename T, size_t SIZE = 0, SinkOverflowPolicy POLICY = SinkOverflowPolicy::Block>
 class SinkBlocking : public SinkBase<T>
 {
 public:
 
+           SinkBlocking();
            SinkBlocking(size_t const size);
   virtual ~SinkBlocking() { }
 
   virtual T pop() override;
   virtual void inject(T const & value) override;
+  virtual void inject(T const * values, size_t const num) override;
+  virtual size_t pop(T * values, size_t const max, rtos::Kernel::Clock::duration_u32 const timeout = rtos::Kernel::wait_for_u32_forever) override;
+  virtual bool inject_for(T const & value, rtos::Kernel::Clock::duration_u32 const timeout) override;
 
 
 private:
 
-  CircularBuffer<T> _data;
+  CircularBuffer<T, (SIZE == 0) ? 0 : nextPowerOfTwo(SIZE)> _data;
   rtos::Mutex _mutex;
   rtos::ConditionVariable _cond_data_available;
   rtos::ConditionVariable _cond_slot_available;
 
+  size_t freeSlots() const;
+};
+
+/* Sink for the common case of exactly one producer thread (the thread
+ * calling Source<T>::push()) and exactly one consumer thread (the thread
+ * calling pop()). Data is exchanged via a lock-free ring buffer, only
+ * when the ring buffer is empty (full) the consumer (producer) thread is
+ * suspended until it is resumed via SINK_SPSC_THREAD_FLAG.
+ */
+template<typename T, size_t SIZE>
+class SinkSpsc : public SinkBase<T>
+{
+public:
+
+  static_assert(isPowerOfTwo(SIZE), "SinkSpsc: SIZE must be a power of two");
+
+           SinkSpsc();
+  virtual ~SinkSpsc() { }
+
+  virtual T pop() override;
+  virtual void inject(T const & value) override;
+  virtual void inject(T const * values, size_t const num) override;
+  virtual size_t pop(T * values, size_t const max, rtos::Kernel::Clock::duration_u32 const timeout = rtos::Kernel::wait_for_u32_forever) override;
+  virtual bool inject_for(T const & value, rtos::Kernel::Clock::duration_u32 const timeout) override;
+
+
+private:
+
+  static size_t constexpr MASK = SIZE - 1;
+
+  /* Written by the producer thread only. */
+  alignas(ARDUINO_THREADS_CACHE_LINE_SIZE) std::atomic<size_t> _write_idx;
+  size_t _read_idx_cache;
+  std::atomic<osThreadId_t> _producer_waiting;
+
+  /* Written by the consumer thread only. */
+  alignas(ARDUINO_THREADS_CACHE_LINE_SIZE) std::atomic<size_t> _read_idx;
+  size_t _write_idx_cache;
+  std::atomic<osThreadId_t> _consumer_waiting;
+
+  alignas(ARDUINO_THREADS_CACHE_LINE_SIZE) T _data[SIZE];
+
+  size_t waitForData(size_t const read_idx, rtos::Kernel::Clock::duration_u32 const timeout);
+  size_t waitForSpace(size_t const write_idx, rtos::Kernel::Clock::duration_u32 const timeout);
+  void commitRead(size_t const read_idx);
+  void commitWrite(size_t const write_idx);
 };
 
 /**************************************************************************************
@@ -89,51 +222,353 @@ private:
 template<typename T>
 T SinkNonBlocking<T>::pop()
 {
-  _mutex.lock();
-  return _data;
-  _mutex.unlock();
+  T value;
+  pop(value);
+  return value;
 }
 
 template<typename T>
 void SinkNonBlocking<T>::inject(T const & value)
 {
-  _mutex.lock();
-  _data = value;
-  _mutex.unlock();
+  _data.push(value);
+}
+
+template<typename T>
+size_t SinkNonBlocking<T>::pop(T * values, size_t const max, rtos::Kernel::Clock::duration_u32 const /* timeout */)
+{
+  if (max == 0)
+    return 0;
+  return pop(values[0]) ? 1 : 0;
+}
+
+template<typename T>
+bool SinkNonBlocking<T>::pop(T & value)
+{
+  uint32_t sequence;
+  value = _data.peek(sequence);
+  bool const is_fresh = (sequence != _last_sequence);
+  _last_sequence = sequence;
+  return is_fresh;
 }
 
 /**************************************************************************************
  * PUBLIC MEMBER FUNCTIONS - SinkBlocking
  **************************************************************************************/
 
-template<typename T>
-SinkBlocking<T>::SinkBlocking(size_t const size)
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+SinkBlocking<T,SIZE,POLICY>::SinkBlocking()
+: _cond_data_available(_mutex)
+, _cond_slot_available(_mutex)
+{
+  static_assert(SIZE > 0, "SinkBlocking<T>: size must be passed to the constructor");
+}
+
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+SinkBlocking<T,SIZE,POLICY>::SinkBlocking(size_t const size)
 : _data(size)
 , _cond_data_available(_mutex)
 , _cond_slot_available(_mutex)
-{ }
+{
+  static_assert(SIZE == 0, "SinkBlocking<T, SIZE>: size is a template parameter");
+}
 
-template<typename T>
-T SinkBlocking<T>::pop()
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+T SinkBlocking<T,SIZE,POLICY>::pop()
 {
   _mutex.lock();
   while (_data.isEmpty())
     _cond_data_available.wait();
-  T const d = _data.read();
+  T d = _data.read();
   _cond_slot_available.notify_all();
   _mutex.unlock();
   return d;
 }
 
-template<typename T>
-void SinkBlocking<T>::inject(T const & value)
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+void SinkBlocking<T,SIZE,POLICY>::inject(T const & value)
+{
+  SinkBlocking::inject_for(value, rtos::Kernel::wait_for_u32_forever);
+}
+
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+void SinkBlocking<T,SIZE,POLICY>::inject(T const * values, size_t const num)
 {
+  if (POLICY != SinkOverflowPolicy::Block)
+  {
+    for (size_t i = 0; i < num; i++)
+      SinkBlocking::inject_for(values[i], rtos::Kernel::wait_for_u32_forever);
+    return;
+  }
+
   _mutex.lock();
-  while (_data.isFull())
-    _cond_slot_available.wait();
+  size_t num_stored = 0;
+  while (num_stored < num)
+  {
+    while (freeSlots() == 0)
+      _cond_slot_available.wait();
+    num_stored += _data.store(values + num_stored, std::min(num - num_stored, freeSlots()));
+    _cond_data_available.notify_all();
+  }
+  _mutex.unlock();
+}
+
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+bool SinkBlocking<T,SIZE,POLICY>::inject_for(T const & value, rtos::Kernel::Clock::duration_u32 const timeout)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+
+  if (freeSlots() == 0)
+  {
+    auto const deadline = rtos::Kernel::Clock::now() + timeout;
+
+    switch (POLICY)
+    {
+      case SinkOverflowPolicy::Block:
+        while (freeSlots() == 0)
+        {
+          if (timeout == rtos::Kernel::wait_for_u32_forever)
+            _cond_slot_available.wait();
+          else if (_cond_slot_available.wait_until(deadline) && (freeSlots() == 0))
+            return false;
+        }
+        break;
+      case SinkOverflowPolicy::DropNewest:
+        return false;
+      case SinkOverflowPolicy::DropOldest:
+        _data.read();
+        break;
+      case SinkOverflowPolicy::Overwrite:
+        _data.newest() = value;
+        _cond_data_available.notify_all();
+        return true;
+    }
+  }
+
   _data.store(value);
   _cond_data_available.notify_all();
+  return true;
+}
+
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+size_t SinkBlocking<T,SIZE,POLICY>::pop(T * values, size_t const max, rtos::Kernel::Clock::duration_u32 const timeout)
+{
+  if (max == 0)
+    return 0;
+
+  _mutex.lock();
+  auto const deadline = _data.isEmpty() ? (rtos::Kernel::Clock::now() + timeout) : rtos::Kernel::Clock::time_point{};
+  while (_data.isEmpty())
+  {
+    if (timeout == rtos::Kernel::wait_for_u32_forever)
+      _cond_data_available.wait();
+    else if (_cond_data_available.wait_until(deadline) && _data.isEmpty())
+    {
+      _mutex.unlock();
+      return 0;
+    }
+  }
+  size_t const num_read = _data.read(values, max);
+  _cond_slot_available.notify_all();
   _mutex.unlock();
+  return num_read;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS - SinkBlocking
+ **************************************************************************************/
+
+template<typename T, size_t SIZE, SinkOverflowPolicy POLICY>
+size_t SinkBlocking<T,SIZE,POLICY>::freeSlots() const
+{
+  /* A static sink may only use SIZE slots of its (power of two) storage. */
+  size_t const capacity = (SIZE == 0) ? _data.capacity() : SIZE;
+  return (capacity - _data.size());
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS - SinkSpsc
+ **************************************************************************************/
+
+template<typename T, size_t SIZE>
+SinkSpsc<T,SIZE>::SinkSpsc()
+: _write_idx{0}
+, _read_idx_cache{0}
+, _producer_waiting{nullptr}
+, _read_idx{0}
+, _write_idx_cache{0}
+, _consumer_waiting{nullptr}
+{ }
+
+template<typename T, size_t SIZE>
+T SinkSpsc<T,SIZE>::pop()
+{
+  size_t const read_idx = _read_idx.load(std::memory_order_relaxed);
+  waitForData(read_idx, rtos::Kernel::wait_for_u32_forever);
+  T value = std::move(_data[read_idx & MASK]);
+  commitRead(read_idx + 1);
+  return value;
+}
+
+template<typename T, size_t SIZE>
+void SinkSpsc<T,SIZE>::inject(T const & value)
+{
+  size_t const write_idx = _write_idx.load(std::memory_order_relaxed);
+  waitForSpace(write_idx, rtos::Kernel::wait_for_u32_forever);
+  _data[write_idx & MASK] = value;
+  commitWrite(write_idx + 1);
+}
+
+template<typename T, size_t SIZE>
+bool SinkSpsc<T,SIZE>::inject_for(T const & value, rtos::Kernel::Clock::duration_u32 const timeout)
+{
+  size_t const write_idx = _write_idx.load(std::memory_order_relaxed);
+  if (waitForSpace(write_idx, timeout) == 0)
+    return false;
+  _data[write_idx & MASK] = value;
+  commitWrite(write_idx + 1);
+  return true;
+}
+
+template<typename T, size_t SIZE>
+void SinkSpsc<T,SIZE>::inject(T const * values, size_t const num)
+{
+  size_t num_stored = 0;
+  while (num_stored < num)
+  {
+    size_t const write_idx = _write_idx.load(std::memory_order_relaxed);
+    size_t const num_to_store = std::min(num - num_stored, waitForSpace(write_idx, rtos::Kernel::wait_for_u32_forever));
+    /* Copy in at most two contiguous segments, see CircularBuffer. */
+    size_t const idx = write_idx & MASK;
+    size_t const num_first = std::min(num_to_store, SIZE - idx);
+    std::copy(values + num_stored, values + num_stored + num_first, _data + idx);
+    std::copy(values + num_stored + num_first, values + num_stored + num_to_store, _data);
+    commitWrite(write_idx + num_to_store);
+    num_stored += num_to_store;
+  }
+}
+
+template<typename T, size_t SIZE>
+size_t SinkSpsc<T,SIZE>::pop(T * values, size_t const max, rtos::Kernel::Clock::duration_u32 const timeout)
+{
+  if (max == 0)
+    return 0;
+
+  size_t const read_idx = _read_idx.load(std::memory_order_relaxed);
+  size_t const num_to_read = std::min(max, waitForData(read_idx, timeout));
+  if (num_to_read == 0)
+    return 0;
+
+  size_t const idx = read_idx & MASK;
+  size_t const num_first = std::min(num_to_read, SIZE - idx);
+  std::move(_data + idx, _data + idx + num_first, values);
+  std::move(_data, _data + (num_to_read - num_first), values + num_first);
+  commitRead(read_idx + num_to_read);
+  return num_to_read;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS - SinkSpsc
+ **************************************************************************************/
+
+template<typename T, size_t SIZE>
+size_t SinkSpsc<T,SIZE>::waitForData(size_t const read_idx, rtos::Kernel::Clock::duration_u32 const timeout)
+{
+  if (_write_idx_cache != read_idx)
+    return (_write_idx_cache - read_idx);
+
+  _write_idx_cache = _write_idx.load(std::memory_order_acquire);
+  if (_write_idx_cache != read_idx)
+    return (_write_idx_cache - read_idx);
+
+  auto const deadline = rtos::Kernel::Clock::now() + timeout;
+
+  for (;;)
+  {
+    /* The sink is empty. Announce that the consumer is about to be
+     * suspended and check again afterwards, otherwise a value injected
+     * in between would not result in the consumer being resumed.
+     */
+    _consumer_waiting.store(rtos::ThisThread::get_id(), std::memory_order_seq_cst);
+    _write_idx_cache = _write_idx.load(std::memory_order_seq_cst);
+    if (_write_idx_cache == read_idx)
+    {
+      if (timeout == rtos::Kernel::wait_for_u32_forever)
+        rtos::ThisThread::flags_wait_any(SINK_SPSC_THREAD_FLAG);
+      else
+      {
+        auto const now = rtos::Kernel::Clock::now();
+        if (now >= deadline)
+        {
+          _consumer_waiting.store(nullptr, std::memory_order_relaxed);
+          return 0;
+        }
+        rtos::ThisThread::flags_wait_any_for(SINK_SPSC_THREAD_FLAG, impl::remainingUntil(deadline, now));
+      }
+    }
+    _consumer_waiting.store(nullptr, std::memory_order_relaxed);
+    _write_idx_cache = _write_idx.load(std::memory_order_acquire);
+    if (_write_idx_cache != read_idx)
+      return (_write_idx_cache - read_idx);
+  }
+}
+
+template<typename T, size_t SIZE>
+size_t SinkSpsc<T,SIZE>::waitForSpace(size_t const write_idx, rtos::Kernel::Clock::duration_u32 const timeout)
+{
+  if ((write_idx - _read_idx_cache) != SIZE)
+    return SIZE - (write_idx - _read_idx_cache);
+
+  _read_idx_cache = _read_idx.load(std::memory_order_acquire);
+  if ((write_idx - _read_idx_cache) != SIZE)
+    return SIZE - (write_idx - _read_idx_cache);
+
+  auto const deadline = rtos::Kernel::Clock::now() + timeout;
+
+  for (;;)
+  {
+    /* The sink is full, see waitForData() for the suspend/resume protocol. */
+    _producer_waiting.store(rtos::ThisThread::get_id(), std::memory_order_seq_cst);
+    _read_idx_cache = _read_idx.load(std::memory_order_seq_cst);
+    if ((write_idx - _read_idx_cache) == SIZE)
+    {
+      if (timeout == rtos::Kernel::wait_for_u32_forever)
+        rtos::ThisThread::flags_wait_any(SINK_SPSC_THREAD_FLAG);
+      else
+      {
+        auto const now = rtos::Kernel::Clock::now();
+        if (now >= deadline)
+        {
+          _producer_waiting.store(nullptr, std::memory_order_relaxed);
+          return 0;
+        }
+        rtos::ThisThread::flags_wait_any_for(SINK_SPSC_THREAD_FLAG, impl::remainingUntil(deadline, now));
+      }
+    }
+    _producer_waiting.store(nullptr, std::memory_order_relaxed);
+    _read_idx_cache = _read_idx.load(std::memory_order_acquire);
+    if ((write_idx - _read_idx_cache) != SIZE)
+      return SIZE - (write_idx - _read_idx_cache);
+  }
+}
+
+template<typename T, size_t SIZE>
+void SinkSpsc<T,SIZE>::commitRead(size_t const read_idx)
+{
+  _read_idx.store(read_idx, std::memory_order_seq_cst);
+
+  osThreadId_t const producer = _producer_waiting.load(std::memory_order_seq_cst);
+  if (producer)
+    osThreadFlagsSet(producer, SINK_SPSC_THREAD_FLAG);
+}
+
+template<typename T, size_t SIZE>
+void SinkSpsc<T,SIZE>::commitWrite(size_t const write_idx)
+{
+  _write_idx.store(write_idx, std::memory_order_seq_cst);
+
+  osThreadId_t const consumer = _consumer_waiting.load(std::memory_order_seq_cst);
+  if (consumer)
+    osThreadFlagsSet(consumer, SINK_SPSC_THREAD_FLAG);
 }
 
 #endif /* ARDUINO_THREADS_SINK_HPP_ */
@@ -0,0 +1,218 @@
+/*
+ * This file is part of the Arduino_ThreadsafeIO library.
+ * Copyright (c) 2021 Arduino SA.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef ARDUINO_THREADS_SLOT_HPP_
+#define ARDUINO_THREADS_SLOT_HPP_
+
+/**************************************************************************************
+ * INCLUDE
+ **************************************************************************************/
+
+#include <mbed.h>
+
+/**************************************************************************************
+ * FORWARD DECLARATION
+ **************************************************************************************/
+
+template<typename T>
+class SlotPoolBase;
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace impl
+{
+
+template<typename T>
+struct SlotEntry
+{
+  T value;
+  volatile uint32_t ref_cnt;
+  SlotPoolBase<T> * pool;
+  SlotEntry * next_free;
+};
+
+} /* namespace impl */
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Slot<T> is a reference counted handle to a value stored within a
+ * SlotPool. Copying a Slot only increments the reference counter, the
+ * value is returned to its pool once the last handle is destroyed.
+ * The value is read-only, it is written before the slot is published.
+ */
+template<typename T>
+class Slot
+{
+public:
+
+  Slot() : _entry(nullptr) { }
+  Slot(Slot const & other) : _entry(other._entry) { acquire(); }
+  Slot(Slot && other) : _entry(other._entry) { other._entry = nullptr; }
+  ~Slot() { release(); }
+
+  Slot & operator = (Slot const & other);
+  Slot & operator = (Slot && other);
+
+  inline T const & operator *  () const { return _entry->value; }
+  inline T const * operator -> () const { return &_entry->value; }
+  inline explicit operator bool() const { return (_entry != nullptr); }
+
+
+private:
+
+  impl::SlotEntry<T> * _entry;
+
+  explicit Slot(impl::SlotEntry<T> * entry) : _entry(entry) { }
+
+  void acquire();
+  void release();
+
+  template<typename, size_t> friend class SlotPool;
+  template<typename, size_t> friend class Loan;
+};
+
+template<typename T>
+class SlotPoolBase
+{
+public:
+
+  virtual ~SlotPoolBase() { }
+
+  virtual void free(impl::SlotEntry<T> * entry) = 0;
+};
+
+/* A fixed pool of SIZE values of type T, no heap memory is required.
+ * alloc() suspends the calling thread while all slots are in use.
+ */
+template<typename T, size_t SIZE>
+class SlotPool : public SlotPoolBase<T>
+{
+public:
+
+  static_assert(SIZE > 0, "SlotPool: SIZE must be greater than 0");
+
+           SlotPool();
+  virtual ~SlotPool() { }
+
+  SlotPool(SlotPool const &) = delete;
+  SlotPool & operator = (SlotPool const &) = delete;
+
+  Slot<T> alloc();
+  virtual void free(impl::SlotEntry<T> * entry) override;
+
+
+private:
+
+  impl::SlotEntry<T> _entry[SIZE];
+  impl::SlotEntry<T> * _free_head;
+  rtos::Mutex _mutex;
+  rtos::ConditionVariable _cond_slot_available;
+};
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS - Slot
+ **************************************************************************************/
+
+template<typename T>
+Slot<T> & Slot<T>::operator = (Slot const & other)
+{
+  if (_entry != other._entry)
+  {
+    release();
+    _entry = other._entry;
+    acquire();
+  }
+  return *this;
+}
+
+template<typename T>
+Slot<T> & Slot<T>::operator = (Slot && other)
+{
+  if (this != &other)
+  {
+    release();
+    _entry = other._entry;
+    other._entry = nullptr;
+  }
+  return *this;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS - Slot
+ **************************************************************************************/
+
+template<typename T>
+void Slot<T>::acquire()
+{
+  if (_entry)
+    core_util_atomic_incr_u32(&_entry->ref_cnt, 1);
+}
+
+template<typename T>
+void Slot<T>::release()
+{
+  if (_entry && core_util_atomic_decr_u32(&_entry->ref_cnt, 1) == 0)
+    _entry->pool->free(_entry);
+  _entry = nullptr;
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS - SlotPool
+ **************************************************************************************/
+
+template<typename T, size_t SIZE>
+SlotPool<T,SIZE>::SlotPool()
+: _free_head(nullptr)
+, _cond_slot_available(_mutex)
+{
+  for (size_t i = 0; i < SIZE; i++)
+  {
+    _entry[i].ref_cnt = 0;
+    _entry[i].pool = this;
+    _entry[i].next_free = _free_head;
+    _free_head = &_entry[i];
+  }
+}
+
+template<typename T, size_t SIZE>
+Slot<T> SlotPool<T,SIZE>::alloc()
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  while (_free_head == nullptr)
+    _cond_slot_available.wait();
+
+  impl::SlotEntry<T> * entry = _free_head;
+  _free_head = entry->next_free;
+  entry->ref_cnt = 1;
+  return Slot<T>(entry);
+}
+
+template<typename T, size_t SIZE>
+void SlotPool<T,SIZE>::free(impl::SlotEntry<T> * entry)
+{
+  mbed::ScopedLock<rtos::Mutex> lock(_mutex);
+  entry->next_free = _free_head;
+  _free_head = entry;
+  _cond_slot_available.notify_one();
+}
+
+#endif /* ARDUINO_THREADS_SLOT_HPP_ */
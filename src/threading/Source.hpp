@@ -23,8 +23,16 @@
  * INCLUDE
  **************************************************************************************/
 
-#include <list>
-#include <algorithm>
+#include <mbed.h>
+
+#include <tuple>
+#include <utility>
+
+/**************************************************************************************
+ * CONSTANT
+ **************************************************************************************/
+
+static size_t constexpr SOURCE_MAX_SINKS = 8;
 
 /**************************************************************************************
  * FORWARD DECLARATION
@@ -37,37 +45,100 @@ class SinkBase;
  * CLASS DECLARATION
  **************************************************************************************/
 
-template<typename T>
+/* Source<T, MAX_SINKS> can be connected to up to MAX_SINKS sinks, which
+ * are stored within an inline array so that connecting a sink does not
+ * allocate heap memory and pushing a value iterates contiguous memory.
+ */
+template<typename T, size_t MAX_SINKS = SOURCE_MAX_SINKS>
 class Source
 {
 public:
 
-  void connectTo(SinkBase<T> & sink);
+  static_assert(MAX_SINKS > 0, "Source: MAX_SINKS must be greater than 0");
+
+  Source() : _num_sinks(0) { }
+
+  /* Connecting more than MAX_SINKS sinks is a programming error and
+   * fails an assertion, returns false (without connecting the sink)
+   * if assertions are disabled.
+   */
+  bool connectTo(SinkBase<T> & sink);
   void push(T const & val);
+  void push(T const * data, size_t const num);
+  bool push_for(T const & val, rtos::Kernel::Clock::duration_u32 const timeout);
 
 private:
-  std::list<SinkBase<T> *> _sink_list;
+  SinkBase<T> * _sink[MAX_SINKS];
+  size_t _num_sinks;
+};
+
+/* StaticSource<T, SinkTypes...> is connected at construction to sinks
+ * whose types are known at compile time. push() calls each sink's
+ * inject() directly instead of via the virtual SinkBase<T> interface,
+ * which allows the compiler to inline the complete fan-out.
+ */
+template<typename T, typename... SinkTypes>
+class StaticSource
+{
+public:
+
+  StaticSource(SinkTypes & ... sinks) : _sinks(sinks...) { }
+
+  inline void push(T const & val) { push(val, std::index_sequence_for<SinkTypes...>{}); }
+
+private:
+  std::tuple<SinkTypes & ...> _sinks;
+
+  template<size_t... I>
+  inline void push(T const & val, std::index_sequence<I...>)
+  {
+    /* The qualified call prevents a virtual dispatch. */
+    int const unused[] = { 0, (std::get<I>(_sinks).SinkTypes::inject(val), 0)... };
+    (void)unused;
+  }
 };
 
 /**************************************************************************************
  * PUBLIC MEMBER FUNCTIONS
  **************************************************************************************/
 
-template<typename T>
-void Source<T>::connectTo(SinkBase<T> & sink)
+template<typename T, size_t MAX_SINKS>
+bool Source<T,MAX_SINKS>::connectTo(SinkBase<T> & sink)
+{
+  MBED_ASSERT(_num_sinks < MAX_SINKS);
+  if (_num_sinks == MAX_SINKS)
+    return false;
+  _sink[_num_sinks++] = &sink;
+  return true;
+}
+
+template<typename T, size_t MAX_SINKS>
+void Source<T,MAX_SINKS>::push(T const & val)
+{
+  for (size_t i = 0; i < _num_sinks; i++)
+    _sink[i]->inject(val);
+}
+
+template<typename T, size_t MAX_SINKS>
+void Source<T,MAX_SINKS>::push(T const * data, size_t const num)
 {
-  _sink_list.push_back(&sink);
+  for (size_t i = 0; i < _num_sinks; i++)
+    _sink[i]->inject(data, num);
 }
 
-template<typename T>
-void Source<T>::push(T const & val)
+/* Every sink may wait up to 'timeout' for a free slot, returns
+ * false if at least one sink did not accept the value.
+ */
+template<typename T, size_t MAX_SINKS>
+bool Source<T,MAX_SINKS>::push_for(T const & val, rtos::Kernel::Clock::duration_u32 const timeout)
 {
-  std::for_each(std::begin(_sink_list),
-                std::end  (_sink_list),
-                [val](SinkBase<T> * sink)
-                {
-                  sink->inject(val);
-                });
+  bool accepted_by_all = true;
+  for (size_t i = 0; i < _num_sinks; i++)
+  {
+    if (!_sink[i]->inject_for(val, timeout))
+      accepted_by_all = false;
+  }
+  return accepted_by_all;
 }
 
 #endif /* ARDUINO_THREADS_SOURCE_HPP_ */